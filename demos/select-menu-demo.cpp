@@ -26,6 +26,7 @@
 #include <asgl/ImageWidget.hpp>
 #include <asgl/TextArea.hpp>
 #include <asgl/TextButton.hpp>
+#include <asgl/EventCoalescer.hpp>
 
 #include <asgl/sfml/SfmlEngine.hpp>
 
@@ -243,7 +244,9 @@ public:
         switch (event.type_id()) {
         case k_event_id_of<MousePress>: {
             auto pos = event.as<MousePress>();
-            m_foreground_image.mouse_click(pos.x, pos.y, location());
+            // nothing else needs to see the mouse while this is dragged
+            if (m_foreground_image.mouse_click(pos.x, pos.y, location()))
+                { capture_pointer(); }
             }
             break;
         case k_event_id_of<MouseMove>: {
@@ -253,6 +256,7 @@ public:
             break;
         case k_event_id_of<MouseRelease>:
             m_foreground_image.drag_release();
+            release_pointer();
             break;
         default: break;
         }
@@ -775,12 +779,14 @@ int main() {
         ,std::max(200, test_frame.height()))
         /* title */ ,"");
     win.setFramerateLimit(20);
+    // dragging icons around makes for plenty of mouse moves each frame
+    EventCoalescer coalescer;
     while (win.isOpen()) {
         if (test_frame.is_requesting_exit()) return 0;
         {
         sf::Event event;
         while (win.pollEvent(event)) {
-            test_frame.process_event(SfmlFlatEngine::convert(event));
+            coalescer.push(SfmlFlatEngine::convert(event));
             switch (event.type) {
             case sf::Event::Closed:
                 win.close();
@@ -788,6 +794,7 @@ int main() {
             default: break;
             }
         }
+        coalescer.drain_into(test_frame);
         }
 
         sf::sleep(sf::microseconds(16667));
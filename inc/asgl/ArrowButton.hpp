@@ -62,6 +62,14 @@ public:
      */
     void process_event(const Event &) override;
 
+    EventTypeMask handled_event_types() const final
+        { return event_type_mask_of<MouseMove, MouseRelease>(); }
+
+    bool uses_moves_only_for_hover() const final { return true; }
+
+    /** Arrows with no direction never highlight. */
+    void notify_hover_entered() final;
+
     /** The arrow itself takes an ItemKey style, which is then sent to the
      *  widget renderer/engine.
      */
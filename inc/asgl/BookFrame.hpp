@@ -122,6 +122,10 @@ public:
 
     const Page & current_page() const;
 
+    const Widget * receiving_widget() const final { return this; }
+
+    WidgetFlagsReceiver * as_flags_receiver() final { return this; }
+
 protected:
     BookFrame() {}
 
@@ -139,6 +143,17 @@ protected:
 
     void receive_individual_update_needed(Widget *) final;
 
+    /** Pages capturing the pointer capture it for this whole widget. */
+    void receive_pointer_capture(Widget *) final;
+
+    void receive_pointer_release(Widget *) final;
+
+    void receive_focus_receivers_changed() final;
+
+    void receive_redraw_needed(Widget *) final;
+
+    void receive_region_redraw_needed(const Rectangle &) final;
+
 private:
     void iterate_children_(const ChildWidgetIterator &) final;
 
@@ -103,6 +103,12 @@ public:
 
     void process_focus_event(const Event &) final;
 
+    /** Highlights the button, as a mouse move onto it would. */
+    void notify_hover_entered() override;
+
+    /** Deselects the button, as a mouse move off of it would. */
+    void notify_hover_left() override;
+
     void draw_frame(WidgetRenderer &) const;
 
     /** Sets whether or not this widget is visible to focus advances and for
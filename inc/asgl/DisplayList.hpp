@@ -0,0 +1,102 @@
+/****************************************************************************
+
+    Copyright 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+*****************************************************************************/
+
+
+#pragma once
+
+#include <asgl/Widget.hpp>
+
+#include <vector>
+
+namespace asgl {
+
+/** A display list records calls made to it as a renderer, so that they may
+ *  be replayed later to another renderer, without drawing the widget tree
+ *  again.
+ *
+ *  Geometry is kept as it was when recorded, texts and special drawables are
+ *  kept by pointer (and so are drawn as they are at the time of replay).
+ *  @warning a recording must be discarded (cleared) once anything drawn
+ *           changes, or once any widget recorded is gone
+ */
+class DisplayList final : public WidgetRenderer {
+public:
+    void render_rectangle(const Rectangle &, StyleValue, const void *) final;
+
+    void render_rectangle_pair
+        (const Rectangle &, const Rectangle &, StyleValue, const void *) final;
+
+    void render_triangle(const Triangle &, StyleValue, const void *) final;
+
+    void render_text(const TextBase &) final;
+
+    void render_special(StyleValue, const Widget *) final;
+
+    void set_translation(Vector) final;
+
+    Vector translation() const final { return m_translation; }
+
+    /** Makes every recorded call to the given renderer, in recorded order.
+     *  Recorded translations are relative to the target's translation at the
+     *  time of this call, which is restored afterwards.
+     */
+    void replay(WidgetRenderer &) const;
+
+    void clear();
+
+    bool is_empty() const noexcept { return m_commands.empty(); }
+
+    std::size_t command_count() const noexcept { return m_commands.size(); }
+
+private:
+    enum CommandType : uint8_t {
+        k_rectangle, k_rectangle_pair, k_triangle, k_text, k_special,
+        k_translation
+    };
+
+    struct Command {
+        Command() {}
+        Command(CommandType type_, StyleValue key_, const void * pointer_,
+                std::size_t values_start_):
+            type(type_), key(key_), pointer(pointer_),
+            values_start(values_start_)
+        {}
+
+        CommandType type = k_rectangle;
+        StyleValue key;
+        // widget specific pointer, text or widget depending on type
+        const void * pointer = nullptr;
+        // where this command's integers start in the value pool
+        std::size_t values_start = 0;
+    };
+
+    void push_command(CommandType, StyleValue, const void *,
+                      std::initializer_list<int> values);
+
+    std::vector<Command> m_commands;
+    std::vector<int> m_values;
+    Vector m_translation;
+};
+
+} // end of asgl namespace
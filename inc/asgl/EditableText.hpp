@@ -86,6 +86,9 @@ public:
      */
     void process_event(const Event &) final;
 
+    EventTypeMask handled_event_types() const final
+        { return event_type_mask_of<MouseRelease>(); }
+
     /** @copydoc asgl::Widget::location() */
     Vector location() const final { return m_location; }
 
@@ -28,6 +28,8 @@
 
 #include <common/MultiType.hpp>
 
+#include <cstdint>
+
 namespace asgl {
 
 namespace keys {
@@ -217,6 +219,25 @@ using Event = cul::MultiType<
 template <typename T>
 constexpr const int k_event_id_of = Event::GetTypeId<T>::k_value;
 
+// GeneralMotion is the last type of event
+constexpr const int k_event_type_count = k_event_id_of<GeneralMotion> + 1;
+
+static_assert(k_event_type_count <= 32, "event type masks only have room "
+              "for 32 types of events");
+
+/** A set of event types, each being the bit of its type id. */
+using EventTypeMask = uint32_t;
+
+constexpr const EventTypeMask k_all_event_types = ~EventTypeMask(0);
+
+constexpr const EventTypeMask k_no_event_types = EventTypeMask(0);
+
+template <typename ... Types>
+constexpr EventTypeMask event_type_mask_of() {
+    return (k_no_event_types | ... |
+            (EventTypeMask(1) << EventTypeMask(k_event_id_of<Types>)));
+}
+
 Key collapse_numerics(Key);
 
 Key collapse_modifiers(Key);
@@ -227,4 +248,14 @@ char to_char(const keys::KeyEventImpl &);
 
 std::string to_string(const Event &);
 
+/** @returns a copy of the given event, with its mouse location (if it has
+ *           one) moved by the given offset
+ */
+Event translate_mouse_location(const Event &, Vector offset);
+
+/** @returns the mouse location of a pointer event (mouse press, release or
+ *           move), nullptr for any other event
+ */
+const MouseLocation * mouse_location_of(const Event &);
+
 } // end of asgl namespace
@@ -0,0 +1,105 @@
+/****************************************************************************
+
+    Copyright 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+*****************************************************************************/
+
+
+#pragma once
+
+#include <asgl/Event.hpp>
+
+#include <vector>
+
+namespace asgl {
+
+class Widget;
+
+/** Collects events (say those polled for one frame) and collapses bursts of
+ *  mouse and axis moves before they're sent to widgets.
+ *
+ *  Consecutive moves (from the same mouse or joystick axis) are collapsed
+ *  into the latest position, while any other event (presses, releases, keys)
+ *  keeps its place relative to them. Axis moves may also be filtered with a
+ *  deadzone and a change threshold.
+ *
+ *  @code
+ *  while (window.pollEvent(event))
+ *      { coalescer.push(SfmlFlatEngine::convert(event)); }
+ *  coalescer.drain_into(frame);
+ *  @endcode
+ */
+class EventCoalescer final {
+public:
+    /** Axis positions closer to rest than this are taken as at rest (zero).
+     *  @throws if the deadzone is not in [0 1]
+     */
+    void set_axis_deadzone(double);
+
+    /** Axis moves changing position (from the last one kept) by less than
+     *  this are dropped, as are those not changing it at all. Moves to or
+     *  from rest are always kept.
+     *  @throws if the threshold is negative
+     */
+    void set_axis_threshold(double);
+
+    double axis_deadzone() const { return m_axis_deadzone; }
+
+    double axis_threshold() const { return m_axis_threshold; }
+
+    void push(const Event &);
+
+    /** Sends every collected event (in order) to the given widget, leaving
+     *  this empty.
+     */
+    void drain_into(Widget &);
+
+    /** @returns the events collected so far */
+    const std::vector<Event> & events() const { return m_events; }
+
+    bool is_empty() const { return m_events.empty(); }
+
+    void clear();
+
+private:
+    struct AxisRecord {
+        int gamepad_id;
+        int axis_id;
+        double position;
+    };
+
+    void push_mouse_move(const MouseMove &);
+
+    void push_axis_move(AxisMove);
+
+    /** @returns the last axis position kept for the given axis */
+    AxisRecord & record_for(const AxisMove &);
+
+    std::vector<Event> m_events;
+    // moves from here on may be collapsed, everything before is "fenced" by
+    // some other event
+    std::size_t m_moves_start = 0;
+    std::vector<AxisRecord> m_axis_records;
+    double m_axis_deadzone = 0.;
+    double m_axis_threshold = 0.;
+};
+
+} // end of asgl namespace
@@ -0,0 +1,95 @@
+/****************************************************************************
+
+    Copyright 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+*****************************************************************************/
+
+
+#pragma once
+
+#include <asgl/Event.hpp>
+
+#include <atomic>
+#include <memory>
+
+namespace asgl {
+
+class Widget;
+
+/** A bounded queue of events, which any number of threads may push to
+ *  without locking, and one thread (the UI thread) takes them from.
+ *
+ *  This is meant for other threads to inject events (say synthetic general
+ *  motions from game logic), which are then sent to the widget tree once per
+ *  frame with drain_into. Producers never block, an event pushed while the
+ *  queue is full is refused instead.
+ */
+class EventQueue final {
+public:
+    /** @param capacity the most events the queue may hold, rounded up to a
+     *         power of two (and at least two)
+     *  @throws if capacity is zero
+     */
+    explicit EventQueue(std::size_t capacity);
+
+    EventQueue(const EventQueue &) = delete;
+
+    EventQueue & operator = (const EventQueue &) = delete;
+
+    ~EventQueue();
+
+    /** Pushes an event, may be called from any thread.
+     *  @returns false if the queue is full (in which case the event is
+     *           dropped)
+     */
+    bool push(const Event &);
+
+    /** Takes the oldest event, only the consuming thread may call this.
+     *  @returns false if the queue is empty (leaving the event as it was)
+     */
+    bool pop(Event &);
+
+    /** Sends the events queued (at most a queue's worth, so producers cannot
+     *  hold the consumer here) to the given widget, only the consuming
+     *  thread may call this.
+     *  @returns the number of events sent
+     */
+    std::size_t drain_into(Widget &);
+
+    std::size_t capacity() const { return m_mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        Event event;
+    };
+
+    static constexpr const std::size_t k_cache_line_size = 64;
+
+    std::unique_ptr<Cell[]> m_cells;
+    std::size_t m_mask = 0;
+    // producers and the consumer work on different ends, and so are kept on
+    // different cache lines
+    alignas(k_cache_line_size) std::atomic<std::size_t> m_push_position;
+    alignas(k_cache_line_size) std::size_t m_pop_position = 0;
+};
+
+} // end of asgl namespace
@@ -0,0 +1,123 @@
+/****************************************************************************
+
+    Copyright 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+*****************************************************************************/
+
+
+#pragma once
+
+#include <asgl/Event.hpp>
+
+#include <chrono>
+#include <iosfwd>
+#include <vector>
+
+namespace asgl {
+
+class Widget;
+
+/** An event, and when it happened (since recording started). */
+struct RecordedEvent {
+    std::chrono::microseconds time;
+    Event event;
+};
+
+using RecordedEvents = std::vector<RecordedEvent>;
+
+/** Records a session's events with timestamps, so they may be saved and
+ *  later replayed against a widget tree.
+ *
+ *  @code
+ *  auto event = SfmlFlatEngine::convert(sfevent);
+ *  recorder.record(event);
+ *  frame.process_event(event);
+ *  @endcode
+ */
+class EventRecorder final {
+public:
+    /** Starts the clock for timestamps. */
+    EventRecorder();
+
+    /** Records an event, timestamped with the time since the recorder was
+     *  created (or last restarted).
+     */
+    void record(const Event &);
+
+    void record(const Event &, std::chrono::microseconds);
+
+    /** Clears all recorded events and restarts the clock. */
+    void restart();
+
+    const RecordedEvents & events() const { return m_events; }
+
+    /** @see save_recorded_events */
+    void save(std::ostream & out) const;
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+    RecordedEvents m_events;
+};
+
+/** Writes events into a compact binary form, which is the same on any
+ *  platform.
+ */
+void save_recorded_events(std::ostream &, const RecordedEvents &);
+
+/** Reads events written by save_recorded_events.
+ *  @throws if the stream does not hold a recording, or ends part way through
+ *          an event
+ */
+RecordedEvents load_recorded_events(std::istream &);
+
+/** What happened replaying a recording. */
+struct ReplayReport {
+    struct EventResult {
+        RecordedEvent recorded;
+        // processing the event, and then any geometry updates that followed
+        std::chrono::nanoseconds dispatch_time;
+        // number of frames laid out from scratch for this event
+        int layout_count;
+    };
+
+    /** @returns the time taken processing all events */
+    std::chrono::nanoseconds total_dispatch_time() const;
+
+    std::vector<EventResult> events;
+    int layout_count = 0;
+    // bounds of every widget in the tree (depth first, parents before their
+    // children), as the widgets report them after the last event
+    std::vector<Rectangle> final_geometry;
+};
+
+/** Sends recorded events to a widget tree as fast as they can be processed,
+ *  with no display needed. Timestamps are kept for reports but otherwise
+ *  ignored, so replays are deterministic.
+ *
+ *  If the root is a frame, its geometry is updated after each event (as an
+ *  application would do each frame).
+ */
+ReplayReport replay_events(const RecordedEvents &, Widget & root);
+
+/** Writes a (human readable) report, one line per event. */
+void print_replay_report(std::ostream &, const ReplayReport &);
+
+} // end of asgl namespace
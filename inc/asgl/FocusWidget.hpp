@@ -47,8 +47,16 @@ class LinearFocusHandler;
  */
 class FocusReceiver {
 public:
+    FocusReceiver() {}
+
+    /** Copies are not held by any handler, nor have focus or requests. */
+    FocusReceiver(const FocusReceiver &) {}
+
     virtual ~FocusReceiver();
 
+    /** Keeps this receiver's own handler, focus and requests. */
+    FocusReceiver & operator = (const FocusReceiver &) { return *this; }
+
     /** This function is called for any special event processing specific for
      *  to this widget being the focus widget.
      */
@@ -76,8 +84,10 @@ public:
 protected:
     /** A widget may request focus. Frames will respond to requests and reset
      *  them on process_event.
+     *  @note requests are queued with the handler holding this receiver, so
+     *        handlers need not check every receiver on every event
      */
-    void request_focus() { m_request_focus = true; }
+    void request_focus();
 
     /** @returns true when this receiver has the focus, false otherwise
      *  @note returning true while not being the actual focus suggests a bug
@@ -86,8 +96,14 @@ protected:
     bool has_focus() const { return m_has_focus; }
 
 private:
+    friend class LinearFocusHandler;
+
     bool m_request_focus = false;
     bool m_has_focus     = false;
+    // handler which holds this receiver (if any), and this receiver's
+    // position in its list
+    LinearFocusHandler * m_focus_handler = nullptr;
+    std::size_t m_focus_index = 0;
 };
 
 class FocusWidget : public FocusReceiver, public Widget {};
@@ -104,6 +120,18 @@ public:
     using FocusContainer  = std::vector<FocusReceiver *>;
     using FocusContIter   = FocusContainer::iterator;
 
+    LinearFocusHandler() {}
+
+    LinearFocusHandler(const LinearFocusHandler &) = delete;
+
+    LinearFocusHandler(LinearFocusHandler &&) = delete;
+
+    ~LinearFocusHandler();
+
+    LinearFocusHandler & operator = (const LinearFocusHandler &) = delete;
+
+    LinearFocusHandler & operator = (LinearFocusHandler &&) = delete;
+
     /** @brief Sets a function object, when it returns true, it advances the
      *         focus.
      */
@@ -131,7 +159,8 @@ public:
     void process_event(const Event &);
 
     /** This function provides a point for Frames to deposit all focus widgets
-     *  to.
+     *  to. It walks the whole tree, so frames only call it once focus
+     *  receivers have been flagged as changed.
      */
     void check_for_child_widget_updates(Widget &);
 
@@ -153,6 +182,9 @@ public:
     static bool default_focus_regress(const Event &);
 
 private:
+    // receivers queue their own requests
+    friend class FocusReceiver;
+
     class FocusAdvancerFunc {
     public:
         FocusAdvancerFunc(FocusContIter & itr): m_target_itr(itr) {}
@@ -169,13 +201,34 @@ private:
 
     void check_for_visibility_loss();
 
+    /** Answers queued focus requests, in the event that there are several,
+     *  the receiver earliest in the focus order wins.
+     *  @returns the receiver to focus on, or end if there are no requests
+     */
+    FocusContIter take_focus_request();
+
+    void hold_receiver(FocusReceiver &);
+
+    void release_receivers(FocusContIter beg);
+
+    void forget_focus_request(FocusReceiver *);
+
+    /** Clears the receiver's slot (leaving null in its place) and request,
+     *  so that it's never touched again.
+     */
+    void forget_receiver(FocusReceiver &);
+
     void update_focus(FocusContIter & field, FocusContIter new_value) const;
 
     FocusChangeFunc m_advance_func = default_focus_advance;
     FocusChangeFunc m_regress_func = default_focus_regress;
 
+    // slots of receivers destroyed (or taken by other handlers) since the
+    // last rebuild are null
     FocusContainer m_focus_widgets;
     FocusContIter m_current_position;
+    // receivers which have requested focus since the last event
+    std::vector<FocusReceiver *> m_pending_requests;
 };
 
 } // end of asgl namespace
@@ -28,6 +28,8 @@
 #include <asgl/FocusWidget.hpp>
 
 #include <vector>
+#include <array>
+#include <cstdint>
 
 namespace asgl {
 
@@ -68,6 +70,80 @@ private:
     BareFrame * m_parent = nullptr;
 };
 
+/** Batches changes made to widgets of a frame (including those of nested
+ *  frames), so that the frame's geometry is updated only once, as the batch
+ *  ends.
+ *
+ *  While the batch is open, flags raised by the frame's family are kept by
+ *  the frame, rather than passed to its parent, and the frame does not update
+ *  its geometry. Batches may nest, only the outermost batch's end has any
+ *  effect.
+ */
+class LayoutBatch final {
+public:
+    LayoutBatch() {}
+    explicit LayoutBatch(BareFrame &);
+    LayoutBatch(const LayoutBatch &) = delete;
+    LayoutBatch(LayoutBatch &&);
+
+    /** @note when an exception is being thrown the batch is still ended, but
+     *        no geometry update takes place
+     */
+    ~LayoutBatch() noexcept(false);
+
+    LayoutBatch & operator = (const LayoutBatch &) = delete;
+    LayoutBatch & operator = (LayoutBatch &&);
+
+    /** Ends the batch early. If this frame is not a child of another, its
+     *  geometry is updated now (so long as no other batch is open on it).
+     *  Otherwise it is updated along with its parent.
+     */
+    void end();
+
+    void swap(LayoutBatch &);
+
+private:
+    BareFrame * m_frame = nullptr;
+};
+
+/** Describes how wide a column, or how tall a row, of a frame's grid is.
+ *  @see BareFrame::set_grid_layout
+ */
+class GridTrack final {
+public:
+    enum Sizing {
+        // as large as the largest widget in the track
+        k_auto_sizing,
+        // a set number of pixels, regardless of widgets
+        k_fixed_sizing,
+        // a share of space left over by other tracks (but never smaller than
+        // its largest widget)
+        k_fraction_sizing
+    };
+
+    /** An automatically sized track. */
+    GridTrack() {}
+
+    static GridTrack fixed(int pixels);
+
+    /** @param parts the track's share of left over space, relative to other
+     *               fractional tracks, must be positive
+     */
+    static GridTrack fraction(int parts);
+
+    Sizing sizing() const { return m_sizing; }
+
+    /** @returns pixels for fixed tracks, parts for fractional tracks */
+    int amount() const { return m_amount; }
+
+private:
+    GridTrack(Sizing sizing_, int amount_):
+        m_sizing(sizing_), m_amount(amount_) {}
+
+    Sizing m_sizing = k_auto_sizing;
+    int m_amount = 0;
+};
+
 /** @brief A frame is a collection of widgets. This class provides an interface
  *         which allows controling the entire collection widgets as one group.
  *
@@ -184,6 +260,25 @@ public:
 
     Size size() const override;
 
+    /** While a widget (or this frame's decoration) has the pointer captured,
+     *  pointer events skip every other widget, going through each frame
+     *  between here and the capturing widget and nothing else.
+     */
+    void receive_pointer_capture(Widget *) final;
+
+    void receive_pointer_release(Widget *) final;
+
+    /** The (top level) frame rebuilds its list of focus receivers on its next
+     *  geometry update, and only then.
+     */
+    void receive_focus_receivers_changed() final;
+
+    /** Records that something drawn changed, passing it up to the root. */
+    void receive_redraw_needed(Widget *) final;
+
+    /** Records the region as dirty, passing it up to the root. */
+    void receive_region_redraw_needed(const Rectangle &) final;
+
     // <------------------ Frame specific functionality ---------------------->
 
     /** @brief Provides an interface where all widgets maybe added.
@@ -192,6 +287,8 @@ public:
      *         is that this function will not completely finalize the widgets.
      *         Finalization will have to be accomplished a different way, like
      *         calling the overload of this function from the parent frame.
+     *  @note  Widgets added before are not touched, so they may already have
+     *         been destroyed.
      */
     WidgetAdder begin_adding_widgets();
 
@@ -220,8 +317,152 @@ public:
 
     void set_padding(int pixels);
 
+    /** Enables or disables incremental layout for this frame, and all frames
+     *  nested within it (disabled by default).
+     *
+     *  With incremental layout, a geometry update only re-measures children
+     *  whose subtrees have flagged a whole family update. All other children
+     *  keep their cached sizes, and are only re-placed if their locations
+     *  actually change.
+     *  @note widgets which change size should flag a whole family geometry
+     *        update, otherwise their new size may go unnoticed with this
+     *        mode enabled
+     */
+    void set_incremental_layout(bool);
+
+    /** @returns true if incremental layout is enabled for this frame */
+    bool has_incremental_layout() const { return m_incremental_layout; }
+
+    /** Enables or disables placing this frame's widgets relative to the frame
+     *  itself (disabled by default).
+     *
+     *  With relative placement, widgets are placed as though the frame's
+     *  widgets start at the origin. They are translated as they are drawn and
+     *  as they receive mouse events instead, so that moving the frame (say by
+     *  dragging it) need not touch any of its widgets.
+     *  @note a widget's location() is then relative to this frame rather than
+     *        to the render target
+     */
+    void set_relative_placement(bool);
+
+    /** @returns true if relative placement is enabled for this frame */
+    bool has_relative_placement() const { return m_relative_placement; }
+
+    /** Enables or disables laying out this frame's child frames in parallel
+     *  (disabled by default).
+     *
+     *  When more than one child frame needs its size updated, each child
+     *  frame's family is laid out on a small pool of threads, with the rest
+     *  of this frame's layout continuing once they're all done.
+     *  Flags raised by the child frames are held until they're all done.
+     *  @warning widgets in different child frames must not share anything
+     *           which is unsafe to use from different threads while their
+     *           sizes are updated (for instance, a font which loads glyphs as
+     *           they are first needed). The SFML engine's fonts lock while
+     *           loading glyphs, other engines' fonts may not.
+     */
+    void set_parallel_layout(bool);
+
+    /** @returns true if child frames are laid out in parallel */
+    bool has_parallel_layout() const { return m_parallel_layout; }
+
+    /** @returns the number of times this frame has measured and laid out its
+     *           widgets from scratch (updates which only re-place widgets
+     *           are not counted)
+     */
+    int layout_count() const { return m_layout_count; }
+
+    /** Widgets flagging visual changes, geometry updates and moving this
+     *  frame all set this, drawing the frame's widgets unsets it. This way an
+     *  idle UI need not be drawn at all.
+     *  @returns true if anything has changed since this frame was last drawn
+     */
+    bool needs_redraw() const { return m_needs_redraw; }
+
+    /** @returns true if the whole frame must be redrawn (its geometry changed
+     *           or it moved), rather than only its dirty regions
+     */
+    bool needs_full_redraw() const { return m_needs_full_redraw; }
+
+    /** @returns regions changed since this frame was last drawn, as seen by
+     *           this frame's owner, these are only meaningful if a full
+     *           redraw is not needed
+     */
+    const std::vector<Rectangle> & dirty_regions() const
+        { return m_dirty_regions; }
+
+    /** Places this frame's widgets on a grid, rather than into lines.
+     *
+     *  Widgets take cells in the order they are added, row by row, each row
+     *  having as many cells as there are columns. A line seperator ends its
+     *  row early, and a horizontal spacer leaves its cell empty. Rows beyond
+     *  those given are sized automatically. Padding is placed between
+     *  tracks.
+     *  @throws if no columns are given
+     *  @param columns
+     *  @param rows
+     */
+    void set_grid_layout(std::vector<GridTrack> && columns,
+                         std::vector<GridTrack> && rows = std::vector<GridTrack>());
+
+    /** Returns to placing widgets into lines (the default). */
+    void set_line_layout();
+
+    /** @returns true if this frame's widgets are placed on a grid */
+    bool has_grid_layout() const { return !m_grid_columns.empty(); }
+
+    /** Enables or disables sending pointer events (mouse presses, releases
+     *  and moves) only to widgets under the pointer (disabled by default).
+     *
+     *  Widgets are found with a grid over their bounds, which is rebuilt as
+     *  needed after they're laid out. Widgets which were under the pointer
+     *  for the last mouse move are sent pointer events until a move leaves
+     *  them (so they may see it leave), and widgets under the pointer as
+     *  it's pressed are sent every pointer event until the next release (so
+     *  drags may continue outside of them). All other events are still sent
+     *  to every widget.
+     *
+     *  Widgets which only use mouse moves for hover are sent hover
+     *  notifications as the pointer enters and leaves them instead of moves,
+     *  so a pointer moving about inside one button touches only that button.
+     *
+     *  Pointer events nowhere near the frame itself skip its widgets
+     *  altogether, save the first one after the pointer leaves or while a
+     *  press that started inside is held. This also applies to frames
+     *  nested in this one, now and as they're added.
+     *  @warning widgets which need to see pointer events anywhere else should
+     *           not be placed in frames with this enabled
+     */
+    void set_pointer_hit_testing(bool);
+
+    /** @returns true if pointer events only go to widgets under the pointer */
+    bool has_pointer_hit_testing() const { return m_pointer_hit_testing; }
+
+    /** @returns the narrowest width this frame's widgets may be placed in,
+     *           that is the width of its widest widget
+     *  @note intrinsic widths are cached, and only change as children are
+     *        re-measured (as their content or styles change)
+     */
+    int minimum_content_width() const { return m_content_widths.minimum; }
+
+    /** @returns the width this frame's widgets take up with their lines only
+     *           broken by line seperators, any width available beyond this
+     *           goes unused (spacers aside)
+     */
+    int maximum_content_width() const { return m_content_widths.maximum; }
+
+    /** Updates geometry for this frame and its family, if any of it was
+     *  flagged as needing it.
+     *  @note does nothing while a layout batch is open on this frame
+     */
     void check_for_geometry_updates();
 
+    /** Begins a batch of changes to this frame's family.
+     *  @see LayoutBatch
+     *  @returns guard which ends the batch as it is destroyed
+     */
+    LayoutBatch begin_layout_batch();
+
     void swap(BareFrame &);
 
     void draw(WidgetRenderer &) const override;
@@ -232,8 +473,58 @@ public:
 
     void stylize(const StyleMap &) override;
 
+    BareFrame * as_frame() final { return this; }
+
+    const BareFrame * as_frame() const final { return this; }
+
     // detail
-    using WidgetPlacementVector = std::vector<std::tuple<Widget *, Vector>>;
+    /** Geometry of a frame's children, kept as a structure of arrays (one
+     *  entry per child, in the order they were added).
+     *
+     *  A child widget's size is taken once per size update. All line, spacer
+     *  and placement computations then work from, and write to, these
+     *  arrays, which the frame may scan for its children's bounds without
+     *  calling on any of them.
+     */
+    class ChildGeometry {
+    public:
+        enum Flag : uint8_t {
+            k_spacer         = 1 << 0,
+            k_line_seperator = 1 << 1,
+            // first widget (or seperator) of its line
+            k_starts_line    = 1 << 2,
+            // padding precedes this widget (regular widget following another)
+            k_padded         = 1 << 3
+        };
+
+        void clear();
+
+        void reserve(std::size_t);
+
+        void push_back(Widget *, Size, uint8_t flags_);
+
+        std::size_t size() const { return widgets.size(); }
+
+        bool has(std::size_t idx, Flag flag) const
+            { return (flags[idx] & flag) != 0; }
+
+        void set(std::size_t idx, Flag flag, bool b) {
+            if (b) flags[idx] |= flag;
+            else   flags[idx] &= uint8_t(~flag);
+        }
+
+        Vector offset_of(std::size_t idx) const
+            { return Vector(x[idx], y[idx]); }
+
+        Size size_of(std::size_t idx) const
+            { return Size(width[idx], height[idx]); }
+
+        std::vector<Widget *> widgets;
+        // from the decoration's widget start
+        std::vector<int> x, y;
+        std::vector<int> width, height;
+        std::vector<uint8_t> flags;
+    };
 
 protected:
     BareFrame();
@@ -271,11 +562,11 @@ private:
             x_low = y_low = x_high = y_high = 0;
         }
 
-        void record_widget_bounds(Vector location, const Widget & widget) {
+        void record_widget_bounds(Vector location, Size size) {
             x_low  = std::min(x_low , location.x);
             y_low  = std::min(y_low , location.y);
-            x_high = std::max(x_high, location.x + widget.width ());
-            y_high = std::max(y_high, location.y + widget.height());
+            x_high = std::max(x_high, location.x + size.width );
+            y_high = std::max(y_high, location.y + size.height);
         }
 
         Vector recorded_location() const
@@ -299,15 +590,156 @@ private:
         int x_low = IntLims::max(), y_low = IntLims::max(), x_high = IntLims::min(), y_high = IntLims::min();
     };
 
-    static WidgetBoundsFinder get_measurements(const WidgetPlacementVector & widget_placements);
+    // bounds are found relative to where widgets start
+    static WidgetBoundsFinder get_measurements(const ChildGeometry &);
+
+    struct ContentWidths {
+        int minimum = 0;
+        int maximum = 0;
+    };
+
+    static ContentWidths find_content_widths
+        (const ChildGeometry &, int padding_between_widgets);
+
+    /** Uniform grid over children's bounds (as found in child geometry), for
+     *  finding which children are under the pointer.
+     */
+    class ChildHitGrid {
+    public:
+        void build(const ChildGeometry &);
+
+        void clear();
+
+        bool is_built() const { return m_is_built; }
+
+        /** Appends, in order, indices of children whose bounds contain the
+         *  given point (relative to where widgets start).
+         */
+        void find_children_at
+            (const ChildGeometry &, Vector, std::vector<std::size_t> &) const;
+
+    private:
+        Vector m_origin;
+        Size m_cell_size;
+        int m_columns = 0;
+        int m_rows = 0;
+        // children found in cell i are entries [m_cell_starts[i]
+        // m_cell_starts[i + 1])
+        std::vector<std::size_t> m_cell_starts;
+        std::vector<std::size_t> m_entries;
+        bool m_is_built = false;
+    };
+
+    /** Sends a pointer event only to children under the pointer, and those
+     *  which still need to see pointer events.
+     */
+    void send_pointer_event(const Event &, const MouseLocation &);
+
+    /** Tracks the pointer against this frame's bounds.
+     *  @returns true if the given (pointer) event could affect any child,
+     *           always true for any other event
+     */
+    bool pointer_reaches_children(const Event &);
+
+    /** Tells hover only children which the pointer (just moved) entered or
+     *  left.
+     *  @param under_pointer_count children now under the pointer are the
+     *         first this many (sorted) pointer targets
+     */
+    void notify_hover_changes(std::size_t under_pointer_count);
+
+    /** Forgets hovered children without touching them (they may be about to
+     *  be destroyed), keeping those which only use moves for hover to be
+     *  told the pointer left should they be added back.
+     */
+    void release_hover();
+
+    /** Tells those hovered children kept by release_hover, which have been
+     *  added back (and so are known to exist), that the pointer left.
+     */
+    void notify_readded_hover_left();
+
+    /** Sends an event to every child which handles its type. */
+    void send_event_to_subscribers(const Event &);
+
+    /** Builds (per type of event) lists of children which handle them. */
+    void route_child_events();
+
+    bool child_handles(std::size_t child_index, int event_type_id) const;
+
+    /** Places measured children into lines, requesting the size needed from
+     *  the decoration.
+     *  @returns resulting bounds
+     */
+    WidgetBoundsFinder lay_out_lines();
+
+    /** Places measured children on this frame's grid, requesting the size
+     *  needed from the decoration.
+     *  @returns resulting bounds
+     */
+    WidgetBoundsFinder lay_out_grid();
+
+    /** Sizes this frame's grid tracks and writes cell locations to measured
+     *  children. Either dimension may be
+     *  FrameDecoration::k_no_width_limit_for_widgets, in which case fractional
+     *  tracks are sized by their widgets.
+     *  @returns the bounds of the whole grid
+     */
+    WidgetBoundsFinder place_into_grid(int width_for_widgets, int height_for_widgets);
 
     using WidgetItr = std::vector<Widget *>::iterator;
     using LineSeperator = detail::LineSeperator;
     using HorizontalSpacer = detail::HorizontalSpacer;
 
-    void update_horizontal_spacers(const int);
+    friend class LayoutBatch;
+
+    void open_layout_batch();
+
+    void end_layout_batch(bool update_geometry);
 
-    bool contains(const Widget *) const noexcept;
+    /** @returns true if any of the given widgets is this frame or one of
+     *           its ancestors
+     */
+    bool has_lineage_among(const std::vector<Widget *> &) const;
+
+    void adopt(Widget &);
+
+    /** @returns true if the widget was adopted for this frame's current set
+     *           of widgets (widgets since dropped may still name this frame
+     *           as their owner)
+     */
+    bool has_adopted(const Widget *) const;
+
+    bool update_child_sizes();
+
+    void update_sizes_of_children(bool only_flagged);
+
+    // what the last full layout was done with (children's sizes aside), and
+    // where children were last placed from
+    struct LayoutInputs {
+        int padding = 0;
+        int available_width = 0;
+        Size requested_size;
+        Size accepted_size;
+        Vector origin;
+    };
+
+    /** @returns true if this frame has already been laid out, and none of its
+     *           children's sizes differ from those last measured
+     */
+    bool children_kept_sizes() const;
+
+    bool is_flagged(const Widget *) const;
+
+    /** @returns true if every flagged widget is a child of this frame (or
+     *           this frame itself)
+     */
+    bool only_children_flagged() const;
+
+    /** @returns true if padding and the decoration's constraints are such that
+     *           the last layout still applies
+     */
+    bool decoration_kept_constraints();
 
     void iterate_children_(const ChildWidgetIterator &) final;
 
@@ -315,20 +747,79 @@ private:
 
     void update_size() final;
 
-    void get_widget_placements(WidgetPlacementVector &, const int k_horz_space) const;
+    bool is_horizontal_spacer(const Widget *) const noexcept;
+
+    void measure_children();
+
+    void place_measured_children(bool only_flagged_or_moving);
+
+    /** @returns where children are placed from, that is where widgets start,
+     *           or the origin if relative placement is enabled
+     */
+    Vector children_origin() const;
 
     void check_invarients() const;
 
     std::vector<Widget *> m_widgets;
-    WidgetPlacementVector m_widget_placements;
+    ChildGeometry m_child_geometry;
+    // found as children are measured
+    ContentWidths m_content_widths;
     int m_padding = 0;
+    bool m_incremental_layout = false;
+    bool m_relative_placement = false;
+    bool m_parallel_layout = false;
+    int m_open_layout_batches = 0;
+    int m_layout_count = 0;
+
+    // empty if widgets are placed into lines
+    std::vector<GridTrack> m_grid_columns;
+    std::vector<GridTrack> m_grid_rows;
+
+    // this frame itself if its decoration is being dragged
+    Widget * m_pointer_captor = nullptr;
+
+    bool m_pointer_hit_testing = false;
+    // as of the last mouse move, children need to see it leave if so
+    bool m_pointer_was_inside = true;
+    bool m_pointer_pressed_inside = false;
+    ChildHitGrid m_hit_grid;
+    // children (by index) under the pointer as of the last mouse move
+    std::vector<std::size_t> m_hovered_children;
+    // hover only children hovered before the widgets were replaced, these
+    // are only compared against, never dereferenced
+    std::vector<const Widget *> m_formerly_hovered;
+    // children under the pointer as it was pressed, kept until released
+    std::vector<std::size_t> m_pressed_children;
+    std::vector<std::size_t> m_pointer_targets;
+
+    // children (in order) which handle each type of event, taken as they're
+    // added
+    std::array<std::vector<Widget *>, k_event_type_count> m_event_routes;
+    // parallel to m_widgets
+    std::vector<EventTypeMask> m_child_event_types;
+    std::vector<bool> m_hover_only_children;
+    // widgets (including those nested in non frame children) adopted with
+    // the current set of widgets, sorted by address
+    std::vector<const Widget *> m_adopted;
+
+    // widgets which flagged their subtrees, taken at the start of each size
+    // update
+    std::vector<Widget *> m_flagged_subtrees;
+
+    LayoutInputs m_last_inputs;
 
     //! unique per instance
     LineSeperator m_the_line_seperator;
     std::vector<HorizontalSpacer> m_horz_spacers;
 
     LinearFocusHandler m_focus_handler;
+    bool m_focus_receivers_changed = true;
+    // unset by drawing
+    mutable bool m_needs_redraw = true;
+    mutable bool m_needs_full_redraw = true;
+    mutable std::vector<Rectangle> m_dirty_regions;
 
+    // relative to where widgets start
     WidgetBoundsFinder m_widget_extremes;
 };
 
@@ -51,6 +51,9 @@ class LineSeperator final : public Widget {
 public:
     void process_event(const Event &) final {}
 
+    EventTypeMask handled_event_types() const final
+        { return k_no_event_types; }
+
     Vector location() const final { return Vector(); }
 
     Size size() const final { return Size(); }
@@ -68,6 +71,9 @@ class HorizontalSpacer final : public Widget {
 public:
     void process_event(const Event &) final {}
 
+    EventTypeMask handled_event_types() const final
+        { return k_no_event_types; }
+
     Vector location() const final;
 
     Size size() const final;
@@ -210,6 +216,8 @@ public:
 
     void inform_is_child();
 
+    using Draggable::is_being_dragged;
+
 protected:
     void update_drag_position(int x, int y) final;
 
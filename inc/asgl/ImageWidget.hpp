@@ -80,6 +80,9 @@ public:
 private:
     void process_event(const Event &) final {}
 
+    EventTypeMask handled_event_types() const final
+        { return k_no_event_types; }
+
     void update_size() final {}
 
     StyleValue item_key() const final;
@@ -54,6 +54,9 @@ public:
 
     void process_event(const Event &) override;
 
+    EventTypeMask handled_event_types() const final
+        { return event_type_mask_of<MouseMove, MouseRelease>(); }
+
     Vector location() const override;
 
     Size size() const override;
@@ -42,6 +42,9 @@ public:
     /** ProgressBars do not respond to any event. */
     void process_event(const Event &) override {}
 
+    EventTypeMask handled_event_types() const final
+        { return k_no_event_types; }
+
     Vector location() const override;
 
     /** Sets the size of the control.
@@ -40,6 +40,9 @@ public:
     /** Does nothing, as a plain text area does not interact with events. */
     void process_event(const Event &) final {}
 
+    EventTypeMask handled_event_types() const final
+        { return k_no_event_types; }
+
     /** @copydoc Widget::location() */
     Vector location() const final;
 
@@ -45,6 +45,12 @@ public:
 
     void draw(WidgetRenderer &) const final;
 
+    /** Buttons only respond to the mouse moving and being released. */
+    EventTypeMask handled_event_types() const final
+        { return event_type_mask_of<MouseMove, MouseRelease>(); }
+
+    bool uses_moves_only_for_hover() const final { return true; }
+
 private:
     void set_location_(int x, int y) final;
 
@@ -33,6 +33,7 @@
 namespace asgl {
 
 class Widget;
+class BareFrame;
 
 /** @brief Child widget iterator enables a way to iterate all the child widgets
  *         for some given parent widget.
@@ -67,9 +68,49 @@ public:
     virtual ~WidgetFlagsReceiver();
     virtual void receive_whole_family_upate_needed() = 0;
 
+    /** Called when a widget needs its size recomputed, which in turn may
+     *  affect the whole family.
+     *
+     *  Receivers which are able to narrow the update down to the flagging
+     *  widget's subtree may override this, by default this is treated as a
+     *  whole family update.
+     */
+    virtual void receive_subtree_update_needed(Widget *)
+        { receive_whole_family_upate_needed(); }
+
     // this design requires passing a "this" pointer
     virtual void receive_individual_update_needed(Widget *) = 0;
 
+    /** @returns this receiver as a widget, if it is one, nullptr otherwise */
+    virtual const Widget * receiving_widget() const { return nullptr; }
+
+    /** Called when a widget wants every pointer event for itself (say while
+     *  it's being dragged), until it releases the pointer.
+     *
+     *  Receivers which send out events should pass these along to their own
+     *  receivers, by default this does nothing.
+     */
+    virtual void receive_pointer_capture(Widget *) {}
+
+    /** Called when a widget which captured the pointer is done with it. */
+    virtual void receive_pointer_release(Widget *) {}
+
+    /** Called when focus receivers may have been added or removed somewhere
+     *  below this receiver. By default this does nothing.
+     */
+    virtual void receive_focus_receivers_changed() {}
+
+    /** Called when a widget's appearance changed without any change to its
+     *  geometry (say a button being highlighted). By default this does
+     *  nothing.
+     */
+    virtual void receive_redraw_needed(Widget *) {}
+
+    /** Called with a region (in the coordinates of this receiver's children)
+     *  which must be redrawn. By default this does nothing.
+     */
+    virtual void receive_region_redraw_needed(const Rectangle &) {}
+
     static WidgetFlagsReceiver & null_instance();
 };
 
@@ -95,6 +136,14 @@ public:
 
     // there is no way to double dispatch this or to *not* pass a this pointer
     virtual void render_special(StyleValue, const Widget * instance_pointer) = 0;
+
+    /** Sets an offset applied to everything rendered after this call. Frames
+     *  placing their widgets relative to themselves use this while drawing
+     *  them.
+     */
+    virtual void set_translation(Vector) = 0;
+
+    virtual Vector translation() const = 0;
 };
 
 /** A frame needs four things from a widget, in order to position the widget
@@ -145,6 +194,34 @@ public:
 
     virtual void process_event(const Event &) = 0;
 
+    /** @returns the types of events this widget's process_event does anything
+     *           with, all of them by default
+     *  @note Frames take this once, as widgets are added to them, and then
+     *        only send widgets events of the types they handle. So this must
+     *        not change while the widget is in a frame.
+     */
+    virtual EventTypeMask handled_event_types() const
+        { return k_all_event_types; }
+
+    /** @returns true if all this widget does with mouse moves is tell whether
+     *           the pointer is over it, false by default
+     *  @note Frames tracking hover (those with pointer hit testing) then send
+     *        it hover notifications as the pointer enters and leaves it,
+     *        rather than mouse moves. Like handled_event_types, frames take
+     *        this as widgets are added.
+     */
+    virtual bool uses_moves_only_for_hover() const { return false; }
+
+    /** Called by a frame tracking hover as the pointer moves onto this
+     *  widget.
+     */
+    virtual void notify_hover_entered() {}
+
+    /** Called by a frame tracking hover as the pointer moves off of this
+     *  widget (or as it is taken out of the frame).
+     */
+    virtual void notify_hover_left() {}
+
     /** Sets location of the widget, potentially updating its internal geometry.
      *  @throws If the call changes the size of the widget, widget placement
      *          should *never* change its size.
@@ -199,6 +276,27 @@ public:
      */
     void assign_flags_receiver(WidgetFlagsReceiver * rec);
 
+    /** @returns the widget receiving this widget's flags (that is the frame,
+     *           or other container, which adopted it), or nullptr if there
+     *           isn't one
+     *  @note following owners walks this widget's ancestors, in time
+     *        proportional to its depth in the tree
+     */
+    const Widget * owner() const
+        { return m_flags_receiver->receiving_widget(); }
+
+    /** @returns this widget as a frame, nullptr if it is not one
+     *  @note a cheap alternative to dynamic_cast, so frames need no RTTI on
+     *        their hot paths
+     */
+    virtual BareFrame * as_frame() { return nullptr; }
+
+    /** @copydoc asgl::Widget::as_frame() */
+    virtual const BareFrame * as_frame() const { return nullptr; }
+
+    /** @returns this widget as a flags receiver, nullptr if it is not one */
+    virtual WidgetFlagsReceiver * as_flags_receiver() { return nullptr; }
+
     struct Helpers {
         using FieldFindTuple = std::tuple<StyleValue *, const char *, const StyleField *>;
 
@@ -243,6 +341,34 @@ protected:
      */
     void flag_needs_individual_geometry_update();
 
+    /** Has every pointer event (mouse presses, releases and moves) sent to
+     *  this widget, and no other, until the pointer is released. This is
+     *  meant for drags, so the rest of the tree is left alone while they
+     *  last.
+     */
+    void capture_pointer();
+
+    /** Gives the pointer back to the rest of the tree, does nothing if this
+     *  widget did not capture it.
+     */
+    void release_pointer();
+
+    /** Set this flag if this widget's children changed in a way that may add
+     *  or remove focus receivers. Frames only look for focus receivers when
+     *  this has been flagged.
+     */
+    void flag_focus_receivers_changed();
+
+    /** Set this flag if this widget's appearance changed, but not its
+     *  geometry (geometry updates are always redrawn).
+     */
+    void set_needs_redraw_flag();
+
+    /** Passes a region in need of redrawing up to this widget's receiver.
+     *  This is meant for widgets which own other widgets (like frames).
+     */
+    void flag_region_needs_redraw(const Rectangle &);
+
 private:
     WidgetFlagsReceiver * m_flags_receiver = &WidgetFlagsReceiver::null_instance();
 };
@@ -254,12 +380,24 @@ private:
 class WidgetFlagsReceiverWidget : public Widget, public WidgetFlagsReceiver {
 public:
     /** Sets a flag that the whole family of widgets needs a geometry update.
+     *  This widget itself is recorded as the one requesting it. The flag is
+     *  also passed up to this widget's own flags receiver (if it wasn't set
+     *  already), so that a parent learns which of its children have pending
+     *  updates.
      *  @note this should generally only be called by the Widget class, client
      *        coders should not have to worry about this function (at all!)
      */
     void receive_whole_family_upate_needed() final;
 
+    /** Sets the whole family flag, and records which widget's subtree
+     *  requested it.
+     *  @param wid pointer to the widget that needs its size recomputed
+     */
+    void receive_subtree_update_needed(Widget * wid) final;
+
     /** Sets a flag that an individual widget needs a geometry update.
+     *  This widget is in turn flagged for an individual update with its own
+     *  receiver, so that the update is reachable from the root.
      *  @note This function requires that Widget passes this, therefore this
      *        instance really must be the owning parent object.
      *  @param wid pointer to the widget that needs an individual geometry
@@ -267,6 +405,10 @@ public:
      */
     void receive_individual_update_needed(Widget * wid) final;
 
+    const Widget * receiving_widget() const final { return this; }
+
+    WidgetFlagsReceiver * as_flags_receiver() final { return this; }
+
 protected:
     /** Unsets all geometry update flags for both the whole family and for
      *  individuals.
@@ -277,14 +419,70 @@ protected:
      */
     void unset_flags();
 
+    /** Unsets the whole family flag, moving all widgets which flagged their
+     *  subtrees into the given container.
+     *
+     *  Any flag raised after this call (say while the family is being laid
+     *  out) is kept for the next update, rather than lost.
+     *  @param flagged receives flagging widgets sorted by address without
+     *         duplicates, this may include this widget
+     */
+    void take_whole_family_flags(std::vector<Widget *> & flagged);
+
+    /** Updates geometry for each individually flagged widget, and then unsets
+     *  their individual flags.
+     */
+    void update_flagged_individuals();
+
     /** @returns true if the entire family of widgets needs to update
      *           geometry, false otherwise.
      */
     bool needs_whole_family_geometry_update() const;
 
+    /** Keeps any flags raised from here on with this widget, rather than
+     *  passing them up to its own receiver. Holds may nest.
+     *
+     *  This includes redraw regions, focus receiver changes, and pointer
+     *  captures passed up with the functions below.
+     */
+    void hold_flags();
+
+    /** Releases one hold. Once all holds are released, flags which were kept
+     *  are passed up to this widget's own receiver.
+     */
+    void release_flags();
+
+    bool is_holding_flags() const { return m_flag_holds > 0; }
+
+    bool has_flagged_individuals() const { return !m_individuals.empty(); }
+
+    /** Passes a region in need of redrawing up to this widget's receiver,
+     *  or keeps it until flags are released.
+     */
+    void pass_up_region_redraw_needed(const Rectangle &);
+
+    /** Passes a change in focus receivers up to this widget's receiver, or
+     *  keeps it until flags are released.
+     */
+    void pass_up_focus_receivers_changed();
+
+    /** Captures or releases the pointer for this widget with its receiver,
+     *  or keeps the last of these until flags are released.
+     */
+    void pass_up_pointer_capture(bool captured);
+
 private:
     std::vector<Widget *> m_individuals;
+    std::vector<Widget *> m_subtrees;
     bool m_geo_update_flag = false;
+
+    int m_flag_holds = 0;
+    bool m_holding_whole_family_flag = false;
+    bool m_holding_individual_flag = false;
+    bool m_holding_focus_flag = false;
+    bool m_holding_pointer_flag = false;
+    bool m_held_pointer_captured = false;
+    std::vector<Rectangle> m_held_redraw_regions;
 };
 
 // ----------------------------------------------------------------------------
@@ -27,11 +27,16 @@
 #include <asgl/Widget.hpp>
 #include <asgl/ImageWidget.hpp>
 #include <asgl/SampleStyleValues.hpp>
+#include <asgl/DisplayList.hpp>
 
+#include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Window/Event.hpp>
 
+#include <memory>
+
 #include <common/sf/DrawRectangle.hpp>
 #include <common/sf/DrawTriangle.hpp>
 #include <common/SubGrid.hpp>
@@ -70,6 +75,32 @@ public:
 
     void draw(const Widget &, sf::RenderTarget &, sf::RenderStates = sf::RenderStates::Default);
 
+    /** @returns number of draw calls made to the render target by the last
+     *           call to draw
+     */
+    int draw_call_count() const { return m_draw_call_count; }
+
+    /** While retained, the first draw of a widget records everything it
+     *  draws, later draws of the same widget redraw the batches built from
+     *  that recording rather than visiting the whole tree.
+     *  @see discard_display_list
+     */
+    void set_retained_drawing(bool);
+
+    /** Has the next draw visit the whole tree again, and rebuild every batch
+     *  drawn. Frames which need redrawing discard the display list on their
+     *  own, otherwise this must be called once anything visual changes while
+     *  drawing is retained.
+     */
+    void discard_display_list();
+
+    /** While on, widgets are drawn into a cached texture the size of the
+     *  target, which is then drawn onto the target. A frame which only has
+     *  some regions flagged as changed has just those regions redrawn into
+     *  the cache, anything else is redrawn entirely.
+     */
+    void set_partial_redraw(bool);
+
     static const sf::Texture * dynamic_cast_to_texture(SharedImagePtr);
 
     static Event convert(const sf::Event &);
@@ -105,6 +136,19 @@ public:
         DrawRectangle front_rectangle;
     };
 
+    /** One draw call made while drawing the display list, kept so that it
+     *  can be made again as is.
+     */
+    class RetainedBatch {
+    public:
+        // translated already
+        std::vector<sf::Vertex> vertices;
+        const sf::Texture * texture = nullptr;
+        // special drawables are drawn through their own calls instead
+        const sf::Drawable * special = nullptr;
+        Vector translation;
+    };
+
     using SfmlImageResource = detail::SfmlImageResource;
     using SfmlImageResPtr   = std::shared_ptr<SfmlImageResource>;
     using SfmlRenderItem    = cul::MultiType<ColorItem, SfmlImageResPtr,
@@ -125,6 +169,15 @@ public:
         { return DescItemStyles::to_key(e); }
 
 private:
+    void draw_widget(const Widget &, sf::RenderTarget &, sf::RenderStates,
+                     const Rectangle * clip);
+
+    void draw_through_cache(const Widget &, sf::RenderTarget &, sf::RenderStates);
+
+    void draw_retained_batches(sf::RenderTarget &, sf::RenderStates);
+
+    void redraw_cached_region(const Widget &, const Rectangle &);
+
     SharedImagePtr make_image_resource(const std::string & filename) final;
     SharedImagePtr make_image_resource(SharedImagePtr) final;
 
@@ -136,6 +189,23 @@ private:
 
     std::shared_ptr<detail::SfmlFont> m_font_handler;
     bool m_first_setup_done = false;
+
+    // kept between draws, so its capacity is too
+    std::vector<sf::Vertex> m_batch_vertices;
+    int m_draw_call_count = 0;
+
+    bool m_retained_drawing = false;
+    DisplayList m_display_list;
+    // widget the display list belongs to
+    const Widget * m_display_list_owner = nullptr;
+    // batches built from the display list by its first unclipped draw
+    std::vector<RetainedBatch> m_retained_batches;
+
+    bool m_partial_redraw = false;
+    std::unique_ptr<sf::RenderTexture> m_cache;
+    // widget last drawn into the cache
+    const Widget * m_cached_widget = nullptr;
+    std::vector<Rectangle> m_redraw_regions;
 };
 
 namespace detail {
@@ -4,7 +4,7 @@ CONFIG  -= c++11
 
 QMAKE_CXXFLAGS += -std=c++17
 QMAKE_LFLAGS   += -std=c++17
-LIBS           += -ltinyxml2 -lsfml-graphics -lsfml-window -lsfml-system -lz \
+LIBS           += -ltinyxml2 -lsfml-graphics -lsfml-window -lsfml-system -lz -lpthread \
                   -L/usr/lib/x86_64-linux-gnu
 
 linux {
@@ -64,6 +64,10 @@ SOURCES += \
     ../src/EditableText.cpp     \
     ../src/FocusWidget.cpp      \
     ../src/Event.cpp            \
+    ../src/EventCoalescer.cpp   \
+    ../src/EventQueue.cpp       \
+    ../src/EventRecording.cpp   \
+    ../src/DisplayList.cpp      \
     ../src/SelectionMenu.cpp    \
     ../src/BookFrame.cpp
 
@@ -98,6 +102,10 @@ HEADERS += \
     ../inc/asgl/EditableText.hpp      \
     ../inc/asgl/FocusWidget.hpp       \
     ../inc/asgl/Event.hpp             \
+    ../inc/asgl/EventCoalescer.hpp    \
+    ../inc/asgl/EventQueue.hpp        \
+    ../inc/asgl/EventRecording.hpp    \
+    ../inc/asgl/DisplayList.hpp       \
     ../inc/asgl/Defs.hpp
 
 INCLUDEPATH += \
@@ -39,6 +39,11 @@ void ArrowButton::process_event(const Event & evnt) {
     Button::process_event(evnt);
 }
 
+void ArrowButton::notify_hover_entered() {
+    if (m_dir == Direction::k_none) return;
+    Button::notify_hover_entered();
+}
+
 void ArrowButton::stylize(const StyleMap & smap) {
     Button::stylize(smap);
 
@@ -46,6 +46,7 @@ void BookFrame::set_pages(PageContainer && pages) {
         page->assign_flags_receiver(this);
     }
     flag_needs_whole_family_geometry_update();
+    flag_focus_receivers_changed();
 }
 
 void BookFrame::set_pages(const PageContainer & cont) {
@@ -62,6 +63,8 @@ void BookFrame::flip_to_page(int i) {
     }
     m_current_page = m_pages.begin() + i;
     flag_needs_individual_geometry_update();
+    // only the current page's receivers are visible to focus
+    flag_focus_receivers_changed();
 }
 
 void BookFrame::process_event(const Event & event) {
@@ -101,6 +104,22 @@ const BookFrame::Page & BookFrame::current_page() const {
 /* protected */ void BookFrame::receive_individual_update_needed(Widget *)
     { flag_needs_individual_geometry_update(); }
 
+/* protected */ void BookFrame::receive_pointer_capture(Widget *)
+    { capture_pointer(); }
+
+/* protected */ void BookFrame::receive_pointer_release(Widget *)
+    { release_pointer(); }
+
+/* protected */ void BookFrame::receive_focus_receivers_changed()
+    { flag_focus_receivers_changed(); }
+
+/* protected */ void BookFrame::receive_redraw_needed(Widget *)
+    { set_needs_redraw_flag(); }
+
+/* protected */ void BookFrame::receive_region_redraw_needed
+    (const Rectangle & region)
+{ flag_region_needs_redraw(region); }
+
 /* private */ void BookFrame::iterate_children_(const ChildWidgetIterator & itr) {
     if (m_pages.empty()) return;
     itr(**m_current_page);
@@ -99,6 +99,10 @@ void Button::set_press_event(BlankFunctor && func)
 
 void Button::press() { m_press_functor(); }
 
+void Button::notify_hover_entered() { highlight(); }
+
+void Button::notify_hover_left() { deselect(); }
+
 Vector Button::location() const { return top_left_of(m_back); }
 
 Size Button::size() const { return size_of(m_back); }
@@ -122,19 +126,15 @@ bool Button::is_visible() const noexcept { return m_is_visible; }
 }
 
 /* protected */ void Button::deselect() {
+    if (!m_is_hovered) return;
     m_is_hovered = false;
-    // it isn't clear to me how I should go about marking for needing redraw
-#   if 0
     set_needs_redraw_flag();
-#   endif
 }
 
 /* protected */ void Button::highlight() {
+    if (m_is_hovered) return;
     m_is_hovered = true;
-    // it isn't clear to me how I should go about marking for needing redraw
-#   if 0
     set_needs_redraw_flag();
-#   endif
 }
 
 /* protected */ void Button::process_focus_event(const Event & event) {
@@ -145,11 +145,17 @@ bool Button::is_visible() const noexcept { return m_is_visible; }
     }
 }
 
-/* protected */ void Button::notify_focus_gained()
-    { m_is_focused = true; }
+/* protected */ void Button::notify_focus_gained() {
+    if (m_is_focused) return;
+    m_is_focused = true;
+    set_needs_redraw_flag();
+}
 
-/* protected */ void Button::notify_focus_lost()
-    { m_is_focused = false; }
+/* protected */ void Button::notify_focus_lost() {
+    if (!m_is_focused) return;
+    m_is_focused = false;
+    set_needs_redraw_flag();
+}
 
 /* protected */ void Button::set_location_(int x, int y) {
     set_top_left_of(m_back, x, y);
@@ -0,0 +1,128 @@
+/****************************************************************************
+
+    Copyright 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+*****************************************************************************/
+
+
+#include <asgl/DisplayList.hpp>
+
+namespace {
+
+using asgl::Rectangle, asgl::Vector;
+
+Rectangle rectangle_at(const int *);
+
+} // end of <anonymous> namespace
+
+namespace asgl {
+
+void DisplayList::render_rectangle
+    (const Rectangle & rect, StyleValue key, const void * widget_spec_ptr)
+{
+    push_command(k_rectangle, key, widget_spec_ptr,
+                 { rect.left, rect.top, rect.width, rect.height });
+}
+
+void DisplayList::render_rectangle_pair
+    (const Rectangle & first, const Rectangle & second, StyleValue key,
+     const void * widget_spec_ptr)
+{
+    push_command(k_rectangle_pair, key, widget_spec_ptr,
+                 { first .left, first .top, first .width, first .height,
+                   second.left, second.top, second.width, second.height });
+}
+
+void DisplayList::render_triangle
+    (const Triangle & tri, StyleValue key, const void * widget_spec_ptr)
+{
+    using std::get;
+    push_command(k_triangle, key, widget_spec_ptr,
+                 { get<0>(tri).x, get<0>(tri).y, get<1>(tri).x, get<1>(tri).y,
+                   get<2>(tri).x, get<2>(tri).y });
+}
+
+void DisplayList::render_text(const TextBase & text)
+    { push_command(k_text, StyleValue(), &text, {}); }
+
+void DisplayList::render_special(StyleValue key, const Widget * instance_pointer)
+    { push_command(k_special, key, instance_pointer, {}); }
+
+void DisplayList::set_translation(Vector r) {
+    m_translation = r;
+    push_command(k_translation, StyleValue(), nullptr, { r.x, r.y });
+}
+
+void DisplayList::replay(WidgetRenderer & target) const {
+    using std::get;
+    auto base_translation = target.translation();
+    for (const auto & command : m_commands) {
+        const int * values = m_values.data() + command.values_start;
+        switch (command.type) {
+        case k_rectangle:
+            target.render_rectangle(rectangle_at(values), command.key, command.pointer);
+            break;
+        case k_rectangle_pair:
+            target.render_rectangle_pair(rectangle_at(values), rectangle_at(values + 4),
+                                         command.key, command.pointer);
+            break;
+        case k_triangle:
+            target.render_triangle(
+                Triangle(Vector(values[0], values[1]), Vector(values[2], values[3]),
+                         Vector(values[4], values[5])),
+                command.key, command.pointer);
+            break;
+        case k_text:
+            target.render_text(*static_cast<const TextBase *>(command.pointer));
+            break;
+        case k_special:
+            target.render_special(command.key, static_cast<const Widget *>(command.pointer));
+            break;
+        case k_translation:
+            target.set_translation(base_translation + Vector(values[0], values[1]));
+            break;
+        }
+    }
+    target.set_translation(base_translation);
+}
+
+void DisplayList::clear() {
+    m_commands.clear();
+    m_values.clear();
+    m_translation = Vector();
+}
+
+/* private */ void DisplayList::push_command
+    (CommandType type, StyleValue key, const void * pointer,
+     std::initializer_list<int> values)
+{
+    m_commands.emplace_back(type, key, pointer, m_values.size());
+    m_values.insert(m_values.end(), values.begin(), values.end());
+}
+
+} // end of asgl namespace
+
+namespace {
+
+Rectangle rectangle_at(const int * values)
+    { return Rectangle(values[0], values[1], values[2], values[3]); }
+
+} // end of <anonymous> namespace
@@ -193,7 +193,9 @@ void EditableText::draw(WidgetRenderer & target) const {
 }
 
 void EditableText::set_empty_string(const UString & empt_str) {
+    if (m_empty_text.string() == empt_str) return;
     m_empty_text.set_string(empt_str);
+    set_needs_redraw_flag();
 }
 
 void EditableText::set_entered_string(const UString & new_string) {
@@ -268,9 +270,11 @@ const UString & EditableText::entered_string() const
     check_invarients();
 }
 
-/* private */ void EditableText::notify_focus_gained() {}
+/* private */ void EditableText::notify_focus_gained()
+    { set_needs_redraw_flag(); }
 
-/* private */ void EditableText::notify_focus_lost() {}
+/* private */ void EditableText::notify_focus_lost()
+    { set_needs_redraw_flag(); }
 
 /* private */ int EditableText::text_width() const {
     return m_used_width;
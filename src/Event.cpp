@@ -147,6 +147,10 @@ std::string to_string(const Event & event) {
     };
     static auto ke_to_string = [](const keys::KeyEventImpl & ev)
         { return std::string(1, to_char(ev)); };
+    static auto gb_to_string = [](const gamepad::Button & ev) {
+        return std::to_string(ev.button) + " on gamepad "
+               + std::to_string(ev.gamepad_id);
+    };
     switch (event.type_id()) {
     case k_event_id_of<MousePress>:
         return "Mouse button pressed " + me_to_string(event.as<MousePress>());
@@ -168,8 +172,54 @@ std::string to_string(const Event & event) {
         }
         return rv;
     }
+    case k_event_id_of<AxisMove>: {
+        const auto & axis = event.as<AxisMove>();
+        return "Axis moved " + std::to_string(axis.axis_id) + " on gamepad "
+               + std::to_string(axis.gamepad_id) + " to "
+               + std::to_string(axis.position);
+    }
+    case k_event_id_of<ButtonPress>:
+        return "Gamepad button pressed " + gb_to_string(event.as<ButtonPress>());
+    case k_event_id_of<ButtonRelease>:
+        return "Gamepad button released " + gb_to_string(event.as<ButtonRelease>());
+    case k_event_id_of<GeneralMotion>:
+        return "General motion " + std::to_string(int(event.as<GeneralMotion>()));
     default: return "<unidentified event>";
     }
 }
 
+Event translate_mouse_location(const Event & event, Vector offset) {
+    auto translate = [offset](MouseLocation & location) {
+        // no location stays no location
+        if (   location.x == mouse::k_mouse_no_location
+            && location.y == mouse::k_mouse_no_location)
+        { return; }
+        location.x += offset.x;
+        location.y += offset.y;
+    };
+    Event rv = event;
+    switch (rv.type_id()) {
+    case k_event_id_of<MousePress>:
+        translate(rv.as<MousePress>());
+        break;
+    case k_event_id_of<MouseMove>:
+        translate(rv.as<MouseMove>());
+        break;
+    case k_event_id_of<MouseRelease>:
+        translate(rv.as<MouseRelease>());
+        break;
+    default: break;
+    }
+    return rv;
+}
+
+const MouseLocation * mouse_location_of(const Event & event) {
+    switch (event.type_id()) {
+    case k_event_id_of<MousePress>  : return &event.as<MousePress>();
+    case k_event_id_of<MouseMove>   : return &event.as<MouseMove>();
+    case k_event_id_of<MouseRelease>: return &event.as<MouseRelease>();
+    default: return nullptr;
+    }
+}
+
 } // end of asgl namespace
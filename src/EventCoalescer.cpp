@@ -0,0 +1,136 @@
+/****************************************************************************
+
+    Copyright 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+*****************************************************************************/
+
+
+#include <asgl/EventCoalescer.hpp>
+#include <asgl/Widget.hpp>
+
+#include <cmath>
+
+namespace {
+
+using namespace cul::exceptions_abbr;
+
+} // end of <anonymous> namespace
+
+namespace asgl {
+
+void EventCoalescer::set_axis_deadzone(double deadzone) {
+    if (!(deadzone >= 0. && deadzone <= 1.)) {
+        throw InvArg("EventCoalescer::set_axis_deadzone: deadzone must be in "
+                     "[0 1].");
+    }
+    m_axis_deadzone = deadzone;
+}
+
+void EventCoalescer::set_axis_threshold(double threshold) {
+    if (!(threshold >= 0.)) {
+        throw InvArg("EventCoalescer::set_axis_threshold: threshold must be "
+                     "a non-negative number.");
+    }
+    m_axis_threshold = threshold;
+}
+
+void EventCoalescer::push(const Event & event) {
+    switch (event.type_id()) {
+    case k_event_id_of<MouseMove>:
+        push_mouse_move(event.as<MouseMove>());
+        return;
+    case k_event_id_of<AxisMove>:
+        push_axis_move(event.as<AxisMove>());
+        return;
+    default: break;
+    }
+    m_events.push_back(event);
+    m_moves_start = m_events.size();
+}
+
+void EventCoalescer::drain_into(Widget & widget) {
+    // whatever the widget does with these, pushing to this while draining
+    // leaves those for the next drain
+    std::vector<Event> events;
+    events.swap(m_events);
+    m_moves_start = 0;
+    for (const auto & event : events) {
+        widget.process_event(event);
+    }
+    if (!m_events.empty()) return;
+    // keep the buffer around
+    events.clear();
+    m_events.swap(events);
+}
+
+void EventCoalescer::clear() {
+    m_events.clear();
+    m_moves_start = 0;
+}
+
+/* private */ void EventCoalescer::push_mouse_move(const MouseMove & move) {
+    auto end = m_events.end();
+    for (auto itr = m_events.begin() + m_moves_start; itr != end; ++itr) {
+        if (!itr->is_type<MouseMove>()) continue;
+        itr->as<MouseMove>() = move;
+        return;
+    }
+    m_events.push_back(Event(move));
+}
+
+/* private */ void EventCoalescer::push_axis_move(AxisMove move) {
+    if (std::abs(move.position) < m_axis_deadzone) {
+        move.position = 0.;
+    }
+    auto & record = record_for(move);
+    if (move.position == record.position) return;
+    bool rest_changed = (move.position == 0.) != (record.position == 0.);
+    if (   !rest_changed
+        && std::abs(move.position - record.position) < m_axis_threshold)
+    { return; }
+    record.position = move.position;
+
+    auto end = m_events.end();
+    for (auto itr = m_events.begin() + m_moves_start; itr != end; ++itr) {
+        if (!itr->is_type<AxisMove>()) continue;
+        auto & pending = itr->as<AxisMove>();
+        if (   pending.gamepad_id != move.gamepad_id
+            || pending.axis_id    != move.axis_id)
+        { continue; }
+        pending = move;
+        return;
+    }
+    m_events.push_back(Event(move));
+}
+
+/* private */ EventCoalescer::AxisRecord & EventCoalescer::record_for
+    (const AxisMove & move)
+{
+    for (auto & record : m_axis_records) {
+        if (   record.gamepad_id == move.gamepad_id
+            && record.axis_id    == move.axis_id)
+        { return record; }
+    }
+    m_axis_records.push_back(AxisRecord { move.gamepad_id, move.axis_id, 0. });
+    return m_axis_records.back();
+}
+
+} // end of asgl namespace
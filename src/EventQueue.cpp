@@ -0,0 +1,117 @@
+/****************************************************************************
+
+    Copyright 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+*****************************************************************************/
+
+
+#include <asgl/EventQueue.hpp>
+#include <asgl/Widget.hpp>
+
+#include <algorithm>
+
+namespace {
+
+using namespace cul::exceptions_abbr;
+
+std::size_t to_power_of_two(std::size_t);
+
+} // end of <anonymous> namespace
+
+namespace asgl {
+
+EventQueue::EventQueue(std::size_t capacity) {
+    if (capacity == 0) {
+        throw InvArg("EventQueue::EventQueue: capacity must be a positive "
+                     "integer.");
+    }
+    // with a single cell, a filled cell's sequence would equal the next push
+    // position, letting that push overwrite an unread event
+    static constexpr const std::size_t k_min_capacity = 2;
+    capacity = to_power_of_two(std::max(capacity, k_min_capacity));
+    m_cells = std::make_unique<Cell[]>(capacity);
+    m_mask = capacity - 1;
+    // each cell's sequence says whose turn it is: equal to a push position
+    // when it's free for that push, one past it once it's filled
+    for (std::size_t i = 0; i != capacity; ++i) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_push_position.store(0, std::memory_order_relaxed);
+}
+
+EventQueue::~EventQueue() {}
+
+bool EventQueue::push(const Event & event) {
+    auto pos = m_push_position.load(std::memory_order_relaxed);
+    Cell * cell = nullptr;
+    while (true) {
+        cell = &m_cells[pos & m_mask];
+        auto seq = cell->sequence.load(std::memory_order_acquire);
+        auto diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+        if (diff == 0) {
+            // claim this cell, pos is refreshed should another get it first
+            if (m_push_position.compare_exchange_weak
+                (pos, pos + 1, std::memory_order_relaxed))
+            { break; }
+        } else if (diff < 0) {
+            // the consumer has yet to take this cell's last event
+            return false;
+        } else {
+            pos = m_push_position.load(std::memory_order_relaxed);
+        }
+    }
+    cell->event = event;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool EventQueue::pop(Event & event) {
+    auto & cell = m_cells[m_pop_position & m_mask];
+    auto seq = cell.sequence.load(std::memory_order_acquire);
+    if (seq != m_pop_position + 1) return false;
+    event = cell.event;
+    // free for the push a lap later
+    cell.sequence.store(m_pop_position + m_mask + 1, std::memory_order_release);
+    ++m_pop_position;
+    return true;
+}
+
+std::size_t EventQueue::drain_into(Widget & widget) {
+    std::size_t count = 0;
+    Event event;
+    while (count != capacity() && pop(event)) {
+        widget.process_event(event);
+        ++count;
+    }
+    return count;
+}
+
+} // end of asgl namespace
+
+namespace {
+
+std::size_t to_power_of_two(std::size_t x) {
+    std::size_t rv = 1;
+    while (rv < x) rv *= 2;
+    return rv;
+}
+
+} // end of <anonymous> namespace
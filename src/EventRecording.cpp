@@ -0,0 +1,369 @@
+/****************************************************************************
+
+    Copyright 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+*****************************************************************************/
+
+
+#include <asgl/EventRecording.hpp>
+#include <asgl/Frame.hpp>
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <unordered_set>
+
+namespace {
+
+using namespace cul::exceptions_abbr;
+using namespace asgl;
+using std::chrono::microseconds;
+using std::chrono::nanoseconds;
+
+constexpr const char k_magic[] = { 'a', 's', 'g', 'l', 'e', 'v', 't', 's' };
+constexpr const uint8_t k_format_version = 1;
+
+// everything is written little endian, whatever the platform is
+class Writer final {
+public:
+    explicit Writer(std::ostream & out): m_out(out) {}
+
+    void write_u8(uint8_t x) { m_out.put(char(x)); }
+
+    void write_u32(uint32_t x)
+        { for (int i = 0; i != 4; ++i) write_u8(uint8_t(x >> (i*8))); }
+
+    void write_u64(uint64_t x)
+        { for (int i = 0; i != 8; ++i) write_u8(uint8_t(x >> (i*8))); }
+
+    void write_i32(int32_t x) { write_u32(uint32_t(x)); }
+
+    void write_f64(double x) {
+        uint64_t bits = 0;
+        static_assert(sizeof(bits) == sizeof(x), "");
+        std::memcpy(&bits, &x, sizeof(x));
+        write_u64(bits);
+    }
+
+private:
+    std::ostream & m_out;
+};
+
+class Reader final {
+public:
+    explicit Reader(std::istream & in): m_in(in) {}
+
+    /** @returns false if the stream ended before any byte was read */
+    bool read_u8_or_end(uint8_t & x) {
+        auto ch = m_in.get();
+        if (ch == std::istream::traits_type::eof()) return false;
+        x = uint8_t(ch);
+        return true;
+    }
+
+    uint8_t read_u8() {
+        uint8_t rv = 0;
+        if (read_u8_or_end(rv)) return rv;
+        throw RtError("load_recorded_events: recording ended part way "
+                      "through an event.");
+    }
+
+    uint32_t read_u32() {
+        uint32_t rv = 0;
+        for (int i = 0; i != 4; ++i) rv |= uint32_t(read_u8()) << (i*8);
+        return rv;
+    }
+
+    uint64_t read_u64() {
+        uint64_t rv = 0;
+        for (int i = 0; i != 8; ++i) rv |= uint64_t(read_u8()) << (i*8);
+        return rv;
+    }
+
+    int32_t read_i32() { return int32_t(read_u32()); }
+
+    double read_f64() {
+        uint64_t bits = read_u64();
+        double rv = 0.;
+        std::memcpy(&rv, &bits, sizeof(rv));
+        return rv;
+    }
+
+private:
+    std::istream & m_in;
+};
+
+void write_event(Writer &, const Event &);
+
+Event read_event(Reader &, uint8_t type_id);
+
+int count_layouts(const Widget &);
+
+void collect_geometry(const Widget &, std::vector<Rectangle> &);
+
+// calls f once for the widget and once for each widget in its tree, parents
+// before their children
+template <typename Func>
+void for_each_in_tree(const Widget &, Func &&);
+
+} // end of <anonymous> namespace
+
+namespace asgl {
+
+EventRecorder::EventRecorder():
+    m_start(std::chrono::steady_clock::now())
+{}
+
+void EventRecorder::record(const Event & event) {
+    using std::chrono::duration_cast;
+    record(event, duration_cast<microseconds>
+        (std::chrono::steady_clock::now() - m_start));
+}
+
+void EventRecorder::record(const Event & event, microseconds time)
+    { m_events.push_back(RecordedEvent { time, event }); }
+
+void EventRecorder::restart() {
+    m_events.clear();
+    m_start = std::chrono::steady_clock::now();
+}
+
+void EventRecorder::save(std::ostream & out) const
+    { save_recorded_events(out, m_events); }
+
+void save_recorded_events(std::ostream & out, const RecordedEvents & events) {
+    Writer writer(out);
+    for (char ch : k_magic) writer.write_u8(uint8_t(ch));
+    writer.write_u8(k_format_version);
+    for (const auto & recorded : events) {
+        writer.write_u64(uint64_t(recorded.time.count()));
+        writer.write_u8(uint8_t(recorded.event.type_id()));
+        write_event(writer, recorded.event);
+    }
+}
+
+RecordedEvents load_recorded_events(std::istream & in) {
+    Reader reader(in);
+    for (char ch : k_magic) {
+        uint8_t read = 0;
+        if (reader.read_u8_or_end(read) && read == uint8_t(ch)) continue;
+        throw RtError("load_recorded_events: stream does not hold an event "
+                      "recording.");
+    }
+    uint8_t version = 0;
+    if (!reader.read_u8_or_end(version) || version != k_format_version) {
+        throw RtError("load_recorded_events: recording is of an unknown "
+                      "version.");
+    }
+    RecordedEvents events;
+    uint8_t first_byte = 0;
+    while (reader.read_u8_or_end(first_byte)) {
+        // the first byte's already been read
+        uint64_t time = first_byte;
+        for (int i = 1; i != 8; ++i) time |= uint64_t(reader.read_u8()) << (i*8);
+        auto type_id = reader.read_u8();
+        events.push_back(RecordedEvent {
+            microseconds(int64_t(time)), read_event(reader, type_id) });
+    }
+    return events;
+}
+
+nanoseconds ReplayReport::total_dispatch_time() const {
+    nanoseconds rv { 0 };
+    for (const auto & result : events) rv += result.dispatch_time;
+    return rv;
+}
+
+ReplayReport replay_events(const RecordedEvents & events, Widget & root) {
+    using Clock = std::chrono::steady_clock;
+    auto * frame = root.as_frame();
+    // the tree starts out laid out, so that the first event is not charged
+    // for it
+    if (frame) frame->check_for_geometry_updates();
+
+    ReplayReport report;
+    report.events.reserve(events.size());
+    int layouts_before = count_layouts(root);
+    int layouts_at_start = layouts_before;
+    for (const auto & recorded : events) {
+        auto start = Clock::now();
+        root.process_event(recorded.event);
+        if (frame) frame->check_for_geometry_updates();
+        auto dispatch_time = Clock::now() - start;
+
+        int layouts_after = count_layouts(root);
+        report.events.push_back(ReplayReport::EventResult {
+            recorded, std::chrono::duration_cast<nanoseconds>(dispatch_time),
+            layouts_after - layouts_before });
+        layouts_before = layouts_after;
+    }
+    report.layout_count = layouts_before - layouts_at_start;
+    collect_geometry(root, report.final_geometry);
+    return report;
+}
+
+void print_replay_report(std::ostream & out, const ReplayReport & report) {
+    for (const auto & result : report.events) {
+        out << result.recorded.time.count() << "us "
+            << to_string(result.recorded.event) << ": "
+            << result.dispatch_time.count() << "ns, "
+            << result.layout_count << " layouts\n";
+    }
+    out << report.events.size() << " events in "
+        << report.total_dispatch_time().count() << "ns, "
+        << report.layout_count << " layouts\n";
+    for (const auto & rect : report.final_geometry) {
+        out << "(" << rect.left << ", " << rect.top << ") "
+            << rect.width << "x" << rect.height << "\n";
+    }
+}
+
+} // end of asgl namespace
+
+namespace {
+
+void write_event(Writer & writer, const Event & event) {
+    auto write_location = [&writer](const MouseLocation & location) {
+        writer.write_i32(location.x);
+        writer.write_i32(location.y);
+    };
+    auto write_mouse = [&](const mouse::MouseEventImpl & mouse_event) {
+        write_location(mouse_event);
+        writer.write_u8(uint8_t(mouse_event.button));
+    };
+    auto write_key = [&writer](const keys::KeyEventImpl & key_event) {
+        writer.write_i32(int32_t(key_event.key));
+        writer.write_u8(uint8_t(  (key_event.shift  ? 1 : 0)
+                                | (key_event.alt    ? 2 : 0)
+                                | (key_event.ctrl   ? 4 : 0)
+                                | (key_event.system ? 8 : 0)));
+    };
+    auto write_button = [&writer](const gamepad::Button & button) {
+        writer.write_i32(button.gamepad_id);
+        writer.write_i32(button.button);
+    };
+    switch (event.type_id()) {
+    case k_event_id_of<MousePress>  : return write_mouse(event.as<MousePress>());
+    case k_event_id_of<MouseRelease>: return write_mouse(event.as<MouseRelease>());
+    case k_event_id_of<MouseMove>   : return write_location(event.as<MouseMove>());
+    case k_event_id_of<KeyPress>    : return write_key(event.as<KeyPress>());
+    case k_event_id_of<KeyRelease>  : return write_key(event.as<KeyRelease>());
+    case k_event_id_of<KeyTyped>    :
+        return writer.write_u32(uint32_t(event.as<KeyTyped>().code));
+    case k_event_id_of<AxisMove>: {
+        const auto & axis = event.as<AxisMove>();
+        writer.write_i32(axis.gamepad_id);
+        writer.write_i32(axis.axis_id);
+        writer.write_f64(axis.position);
+        return;
+    }
+    case k_event_id_of<ButtonPress>  : return write_button(event.as<ButtonPress>());
+    case k_event_id_of<ButtonRelease>: return write_button(event.as<ButtonRelease>());
+    case k_event_id_of<GeneralMotion>:
+        return writer.write_u8(uint8_t(event.as<GeneralMotion>()));
+    default: break;
+    }
+    throw InvArg("save_recorded_events: cannot record an event with no "
+                 "type.");
+}
+
+Event read_event(Reader & reader, uint8_t type_id) {
+    auto read_location = [&reader](MouseLocation & location) {
+        location.x = reader.read_i32();
+        location.y = reader.read_i32();
+    };
+    auto read_mouse = [&](mouse::MouseEventImpl & mouse_event) {
+        read_location(mouse_event);
+        mouse_event.button = mouse::Button(reader.read_u8());
+    };
+    auto read_key = [&reader](keys::KeyEventImpl & key_event) {
+        key_event.key = keys::Key(reader.read_i32());
+        auto modifiers = reader.read_u8();
+        key_event.shift  = modifiers & 1;
+        key_event.alt    = modifiers & 2;
+        key_event.ctrl   = modifiers & 4;
+        key_event.system = modifiers & 8;
+    };
+    auto read_button = [&reader](gamepad::Button & button) {
+        button.gamepad_id = reader.read_i32();
+        button.button     = reader.read_i32();
+    };
+    switch (type_id) {
+    case k_event_id_of<MousePress>:
+        { MousePress rv; read_mouse(rv); return Event(rv); }
+    case k_event_id_of<MouseRelease>:
+        { MouseRelease rv; read_mouse(rv); return Event(rv); }
+    case k_event_id_of<MouseMove>:
+        { MouseMove rv; read_location(rv); return Event(rv); }
+    case k_event_id_of<KeyPress>:
+        { KeyPress rv; read_key(rv); return Event(rv); }
+    case k_event_id_of<KeyRelease>:
+        { KeyRelease rv; read_key(rv); return Event(rv); }
+    case k_event_id_of<KeyTyped>:
+        { KeyTyped rv; rv.code = char32_t(reader.read_u32()); return Event(rv); }
+    case k_event_id_of<AxisMove>: {
+        AxisMove rv;
+        rv.gamepad_id = reader.read_i32();
+        rv.axis_id    = reader.read_i32();
+        rv.position   = reader.read_f64();
+        return Event(rv);
+    }
+    case k_event_id_of<ButtonPress>:
+        { ButtonPress rv; read_button(rv); return Event(rv); }
+    case k_event_id_of<ButtonRelease>:
+        { ButtonRelease rv; read_button(rv); return Event(rv); }
+    case k_event_id_of<GeneralMotion>:
+        return Event(GeneralMotion(reader.read_u8()));
+    default: break;
+    }
+    throw RtError("load_recorded_events: recording holds an event of an "
+                  "unknown type.");
+}
+
+int count_layouts(const Widget & widget) {
+    int count = 0;
+    for_each_in_tree(widget, [&count](const Widget & member) {
+        if (const auto * frame = member.as_frame()) count += frame->layout_count();
+    });
+    return count;
+}
+
+void collect_geometry(const Widget & widget, std::vector<Rectangle> & geometry) {
+    for_each_in_tree(widget, [&geometry](const Widget & member)
+        { geometry.push_back(member.bounds()); });
+}
+
+template <typename Func>
+void for_each_in_tree(const Widget & widget, Func && f) {
+    // Some widgets (like BareFrame) iterate all of their descendants, others
+    // only their direct children. Recursing covers the latter, and visited
+    // widgets are skipped to avoid repeats from the former.
+    std::unordered_set<const Widget *> visited;
+    auto visit = [&visited, &f](const Widget & member, auto && visit_) -> void {
+        if (!visited.insert(&member).second) return;
+        f(member);
+        member.iterate_children_const_f([&visit_](const Widget & child)
+            { visit_(child, visit_); });
+    };
+    visit(widget, visit);
+}
+
+} // end of <anonymous> namespace
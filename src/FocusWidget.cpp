@@ -26,6 +26,9 @@
 #include <asgl/Frame.hpp>
 
 #include <iostream>
+#include <algorithm>
+
+#include <cassert>
 
 namespace {
 #if 0
@@ -41,8 +44,6 @@ inline void log_change_focus(const char * msg) {
     std::cout << msg << std::endl;
 }
 
-FocusContIter find_requesting_focus(FocusContIter beg, FocusContIter end);
-
 // how many times do I have a wrapping algoritm?
 // if the answer is more than three... in two different projects...
 // time to put it in the cul
@@ -109,16 +110,28 @@ namespace detail {
 
 } // end of detail namespace -> into ::asgl
 #endif
-FocusReceiver::~FocusReceiver() {}
+FocusReceiver::~FocusReceiver() {
+    if (m_focus_handler) m_focus_handler->forget_receiver(*this);
+}
 
 bool FocusReceiver::reset_focus_request() {
     bool rv = m_request_focus;
     m_request_focus = false;
     return rv;
 }
+
+/* protected */ void FocusReceiver::request_focus() {
+    // already queued (or will be when a handler takes this receiver)
+    if (m_request_focus) return;
+    m_request_focus = true;
+    if (m_focus_handler) m_focus_handler->m_pending_requests.push_back(this);
+}
 #if 0
 namespace detail {
 #endif
+LinearFocusHandler::~LinearFocusHandler()
+    { release_receivers(m_focus_widgets.begin()); }
+
 void LinearFocusHandler::set_focus_advance(FocusChangeFunc && func) {
     m_advance_func = std::move(func);
 }
@@ -145,7 +158,7 @@ void LinearFocusHandler::process_event(const Event & event) {
         log_change_focus("[asgl] Focus event sent.");
     }
 
-    auto new_focus = find_requesting_focus(m_focus_widgets.begin(), m_focus_widgets.end());
+    auto new_focus = take_focus_request();
     if (new_focus == m_focus_widgets.end()) {
 #       if 0
         auto old_itr = m_current_position;
@@ -215,11 +228,14 @@ void LinearFocusHandler::check_for_child_widget_updates(Widget & parent) {
     bool mismatch_detected = false;
     auto itr = m_focus_widgets.begin();
     // O(n) in virtual calls
+    // Receivers do not register themselves, as focus advances in tree order
+    // which only a walk of the tree gives. Frames instead only call this
+    // when receivers may have been added or removed (or reordered).
     parent.iterate_children_f([&mismatch_detected, &itr, this](Widget & child) {
         auto * focwid = dynamic_cast<FocusReceiver *>(&child);
         if (!focwid) return;
         if (mismatch_detected) {
-            m_focus_widgets.push_back(focwid);
+            hold_receiver(*focwid);
         } else if (   itr == m_focus_widgets.end()
                    || /* (short circuit) or else */ *itr != focwid)
         {
@@ -230,9 +246,10 @@ void LinearFocusHandler::check_for_child_widget_updates(Widget & parent) {
 #               endif
                 (**m_current_position).notify_focus_lost();
             }
+            release_receivers(itr);
             m_focus_widgets.erase(itr, m_focus_widgets.end());
             // warning: itr is now unusable!
-            m_focus_widgets.push_back(focwid);
+            hold_receiver(*focwid);
         }
         if (!mismatch_detected) ++itr;
     });
@@ -243,6 +260,7 @@ void LinearFocusHandler::check_for_child_widget_updates(Widget & parent) {
 }
 
 void LinearFocusHandler::clear_focus_widgets() {
+    release_receivers(m_focus_widgets.begin());
     m_focus_widgets.clear();
     m_current_position = m_focus_widgets.end();
     log_change_focus("[asgl] Focus widgets have been cleared.");
@@ -278,7 +296,7 @@ void LinearFocusHandler::clear_focus_widgets() {
 #   if 0
     if (FocusWidgetAtt::is_visible_for_focus_advance(**itr)) {
 #   endif
-    if ((**itr).is_visible_for_focus_advance()) {
+    if (*itr && (**itr).is_visible_for_focus_advance()) {
         m_target_itr = itr;
         return k_break;
     }
@@ -289,7 +307,10 @@ void LinearFocusHandler::clear_focus_widgets() {
     (FocusContIter start)
 {
     // the "first" advance
-    if (start == m_focus_widgets.end()) return m_focus_widgets.begin();
+    if (start == m_focus_widgets.end()) {
+        return std::find_if(m_focus_widgets.begin(), m_focus_widgets.end(),
+                            [](FocusReceiver * receiver) { return !!receiver; });
+    }
     auto rv = m_focus_widgets.end();
     FocusAdvancerFunc faf(rv);
     wrap_forward(start, m_focus_widgets.begin(), m_focus_widgets.end(), faf);
@@ -301,7 +322,11 @@ void LinearFocusHandler::clear_focus_widgets() {
 {
     if (m_focus_widgets.empty()) return start;
     // the "first" regress here
-    if (start == m_focus_widgets.end()) return m_focus_widgets.end() - 1;
+    if (start == m_focus_widgets.end()) {
+        auto itr = std::find_if(m_focus_widgets.rbegin(), m_focus_widgets.rend(),
+                                [](FocusReceiver * receiver) { return !!receiver; });
+        return itr == m_focus_widgets.rend() ? m_focus_widgets.end() : itr.base() - 1;
+    }
     auto rv = m_focus_widgets.end();
     FocusAdvancerFunc faf(rv);
     wrap_backward(start, m_focus_widgets.begin(), m_focus_widgets.end(), faf);
@@ -349,6 +374,64 @@ void LinearFocusHandler::clear_focus_widgets() {
     m_current_position = new_pos;
 #   endif
 }
+
+/* private */ FocusContIter LinearFocusHandler::take_focus_request() {
+    // explicit requests for focus will override regress/advance events
+    auto new_focus = m_focus_widgets.end();
+    for (auto * receiver : m_pending_requests) {
+        // may have moved onto another handler since requesting
+        if (receiver->m_focus_handler != this) continue;
+        if (!receiver->reset_focus_request()) continue;
+        auto itr = m_focus_widgets.begin() + receiver->m_focus_index;
+        if (new_focus == m_focus_widgets.end() || itr < new_focus)
+            { new_focus = itr; }
+    }
+    m_pending_requests.clear();
+    return new_focus;
+}
+
+/* private */ void LinearFocusHandler::hold_receiver(FocusReceiver & receiver) {
+    // the old handler must not keep a receiver which it won't hear about
+    // being destroyed
+    if (receiver.m_focus_handler && receiver.m_focus_handler != this)
+        { receiver.m_focus_handler->forget_receiver(receiver); }
+    receiver.m_focus_handler = this;
+    receiver.m_focus_index   = m_focus_widgets.size();
+    m_focus_widgets.push_back(&receiver);
+    // requests made while not held by any handler
+    if (receiver.m_request_focus)
+        { m_pending_requests.push_back(&receiver); }
+}
+
+/* private */ void LinearFocusHandler::release_receivers(FocusContIter beg) {
+    // Every non null slot is alive, destroyed receivers clear their own.
+    // Released receivers may be destroyed without telling this handler, so
+    // their requests must go too.
+    for (auto itr = beg; itr != m_focus_widgets.end(); ++itr) {
+        if (!*itr) continue;
+        forget_focus_request(*itr);
+        (**itr).m_focus_handler = nullptr;
+    }
+}
+
+/* private */ void LinearFocusHandler::forget_focus_request
+    (FocusReceiver * receiver)
+{
+    auto itr = std::remove(m_pending_requests.begin(),
+                           m_pending_requests.end(), receiver);
+    m_pending_requests.erase(itr, m_pending_requests.end());
+}
+
+/* private */ void LinearFocusHandler::forget_receiver(FocusReceiver & receiver) {
+    assert(receiver.m_focus_handler == this);
+    auto itr = m_focus_widgets.begin() + receiver.m_focus_index;
+    assert(*itr == &receiver);
+    // no one is left to tell that focus was lost
+    if (itr == m_current_position) m_current_position = m_focus_widgets.end();
+    *itr = nullptr;
+    forget_focus_request(&receiver);
+    receiver.m_focus_handler = nullptr;
+}
 #if 0
 } // end of detail namespace -> into ::asgl
 #endif
@@ -372,19 +455,3 @@ void LinearFocusHandler::update_focus
 }
 
 } // end of asgl namespace
-
-namespace {
-
-FocusContIter find_requesting_focus(FocusContIter beg, FocusContIter end) {
-    // explicit requests for focus will override regress/advance events
-    auto new_focus = end;
-    for (auto itr = beg; itr != end; ++itr) {
-        if ((**itr).reset_focus_request() && new_focus == end) {
-            new_focus = itr;
-            // do not break
-        }
-    }
-    return new_focus;
-}
-
-} // end of <anonymous> namespace
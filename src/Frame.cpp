@@ -24,81 +24,85 @@
 
 #include <asgl/Frame.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <thread>
 
 namespace {
 
 using namespace cul::exceptions_abbr;
-using WidgetPlacementVector = asgl::BareFrame::WidgetPlacementVector;
+using ChildGeometry = asgl::BareFrame::ChildGeometry;
+using asgl::GridTrack;
+using asgl::Vector;
 using asgl::Widget;
 using asgl::detail::HorizontalSpacer;
 using asgl::detail::LineSeperator;
 
-class WidgetPlacerAdapter {
+// places measured widgets into lines from left to right (much like English
+// text)
+void break_into_lines
+    (ChildGeometry &, int width_for_widgets, int padding_between_widgets);
+
+// expands horizontal spacers, so that each line (as found by
+// break_into_lines) fills out the given width, offsets are adjusted to match
+void fill_lines
+    (ChildGeometry &, int width_for_widgets, int padding_between_widgets);
+
+// sizes arrive holding the largest widget in each track, and leave as each
+// track's size, tracks past those given are sized automatically
+void size_grid_tracks
+    (const std::vector<GridTrack> &, std::vector<int> & sizes,
+     int available_space, int padding_between_tracks);
+
+// a small, fixed number of threads shared by all frames which lay out their
+// child frames in parallel
+class LayoutThreadPool final {
 public:
-    virtual ~WidgetPlacerAdapter() {}
-    // should include *all* widgets
-    virtual void on_line_end(int widgets_covered, int ns_width) = 0;
-    virtual void operator () (Widget *, int x, int y) const = 0;
-    virtual bool is_line_seperator(const Widget &) const = 0;
-    virtual bool is_horizontal_spacer(const Widget &) const = 0;
-};
+    using IndexFunc = std::function<void(std::size_t)>;
 
-class PartialWidgetPlacerAdapter : public WidgetPlacerAdapter {
-public:
-    bool is_line_seperator(const Widget & widget) const final;
+    LayoutThreadPool(const LayoutThreadPool &) = delete;
+    LayoutThreadPool(LayoutThreadPool &&) = delete;
 
-    bool is_horizontal_spacer(const Widget & widget) const final;
+    ~LayoutThreadPool();
 
-    void assign_line_seperator(const LineSeperator & ls)
-        { m_line_seperator = &ls; }
+    LayoutThreadPool & operator = (const LayoutThreadPool &) = delete;
+    LayoutThreadPool & operator = (LayoutThreadPool &&) = delete;
 
-    void assign_horizontal_spacers_vector(const std::vector<HorizontalSpacer> & vec)
-        { m_spacers_vector = &vec; }
+    // calls f for each index in [0 count), the calling thread takes part and
+    // this returns once every call is done
+    // f must not throw
+    void run_each(std::size_t count, const IndexFunc & f);
 
-protected:
-    auto horizontal_spacers_begin() { return m_spacers_vector->cbegin(); }
-    auto horizontal_spacers_end  () { return m_spacers_vector->cend  (); }
+    static LayoutThreadPool & instance();
 
 private:
-    const LineSeperator * m_line_seperator = nullptr;
-    const std::vector<HorizontalSpacer> * m_spacers_vector = nullptr;
-};
-
-class HorizontalSpacerUpdater final : public PartialWidgetPlacerAdapter {
-public:
-    using WidgetConstIter = std::vector<Widget *>::const_iterator;
-    using HorzIter        = std::vector<HorizontalSpacer>::iterator;
-
-    ~HorizontalSpacerUpdater() final;
+    LayoutThreadPool();
 
-    void on_line_end(int widgets_covered, int ns_width) final;
+    void work();
 
-    void assign_horizontal_spacers_vector
-        (std::vector<asgl::detail::HorizontalSpacer> & vec);
+    void take_indices(const IndexFunc &, std::size_t count);
 
-    void set_widget_iterators(const std::vector<Widget *> & widgets);
+    std::vector<std::thread> m_workers;
+    // only one run at a time
+    std::mutex m_run_mutex;
 
-    void set_horizontal_space(int sp) { m_horz_space = sp; }
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const IndexFunc * m_job = nullptr;
+    std::size_t m_count = 0;
+    std::size_t m_generation = 0;
+    std::size_t m_active = 0;
+    bool m_stopping = false;
 
-    static bool point_to_same(WidgetConstIter widitr, HorzIter horzitr)
-        { return (*widitr) == &*horzitr; }
-
-    void operator () (Widget *, int, int) const final {}
-
-private:
-    WidgetConstIter m_widget_itr;
-    WidgetConstIter m_widget_end;
-    int m_horz_space = 0;
-    HorzIter m_horz_itr;
+    std::atomic<std::size_t> m_next_index = 0;
 };
 
-void do_placements(WidgetPlacementVector &);
-
-void run_placer_algo
-    (WidgetPlacerAdapter & placer, const std::vector<Widget *> & widgets,
-     int width_for_widgets, int padding_between_widgets);
-
 } // end of <anonymous> namespace
 
 namespace asgl {
@@ -208,6 +212,161 @@ void WidgetAdder::swap(WidgetAdder & rhs) {
 
 // ----------------------------------------------------------------------------
 
+/* static */ GridTrack GridTrack::fixed(int pixels) {
+    Widget::Helpers::verify_non_negative(pixels, "GridTrack::fixed", "pixels");
+    return GridTrack(k_fixed_sizing, pixels);
+}
+
+/* static */ GridTrack GridTrack::fraction(int parts) {
+    if (parts > 0) return GridTrack(k_fraction_sizing, parts);
+    throw InvArg("GridTrack::fraction: parts must be a positive integer.");
+}
+
+// ----------------------------------------------------------------------------
+
+LayoutBatch::LayoutBatch(BareFrame & frame):
+    m_frame(&frame)
+{ m_frame->open_layout_batch(); }
+
+LayoutBatch::LayoutBatch(LayoutBatch && rhs)
+    { swap(rhs); }
+
+LayoutBatch::~LayoutBatch() noexcept(false) {
+    if (!m_frame) return;
+    // the frame must not be left holding flags either way
+    m_frame->end_layout_batch(std::uncaught_exceptions() == 0);
+}
+
+LayoutBatch & LayoutBatch::operator = (LayoutBatch && rhs) {
+    swap(rhs);
+    return *this;
+}
+
+void LayoutBatch::end() {
+    if (!m_frame) return;
+    auto * frame = m_frame;
+    m_frame = nullptr;
+    frame->end_layout_batch(true);
+}
+
+void LayoutBatch::swap(LayoutBatch & rhs)
+    { std::swap(m_frame, rhs.m_frame); }
+
+// ----------------------------------------------------------------------------
+
+void BareFrame::ChildGeometry::clear() {
+    widgets.clear();
+    x.clear();
+    y.clear();
+    width.clear();
+    height.clear();
+    flags.clear();
+}
+
+void BareFrame::ChildGeometry::reserve(std::size_t n) {
+    widgets.reserve(n);
+    x.reserve(n);
+    y.reserve(n);
+    width.reserve(n);
+    height.reserve(n);
+    flags.reserve(n);
+}
+
+void BareFrame::ChildGeometry::push_back
+    (Widget * widget, Size size_, uint8_t flags_)
+{
+    widgets.push_back(widget);
+    x.push_back(0);
+    y.push_back(0);
+    width.push_back(size_.width);
+    height.push_back(size_.height);
+    flags.push_back(flags_);
+}
+
+// ----------------------------------------------------------------------------
+
+void BareFrame::ChildHitGrid::build(const ChildGeometry & geo) {
+    static constexpr const int k_max_cells_per_side = 64;
+    static constexpr const uint8_t k_not_hit =
+        ChildGeometry::k_spacer | ChildGeometry::k_line_seperator;
+    clear();
+    m_is_built = true;
+    auto is_hit = [&geo](std::size_t i)
+        { return !(geo.flags[i] & k_not_hit) && geo.width[i] > 0 && geo.height[i] > 0; };
+
+    WidgetBoundsFinder bounds;
+    long long total_width = 0, total_height = 0;
+    int count = 0;
+    for (std::size_t i = 0; i != geo.size(); ++i) {
+        if (!is_hit(i)) continue;
+        bounds.record_widget_bounds(geo.offset_of(i), geo.size_of(i));
+        total_width  += geo.width [i];
+        total_height += geo.height[i];
+        ++count;
+    }
+    if (count == 0) return;
+
+    // cells about the size of an average child, so that most children are in
+    // only a few cells
+    auto cells_along = [count](int extent, long long total) {
+        int average = std::max(1, int(total / count));
+        return std::min((extent + average - 1) / average, k_max_cells_per_side);
+    };
+    m_origin    = bounds.recorded_location();
+    m_columns   = cells_along(bounds.recorded_width (), total_width );
+    m_rows      = cells_along(bounds.recorded_height(), total_height);
+    m_cell_size = Size((bounds.recorded_width () + m_columns - 1) / m_columns,
+                       (bounds.recorded_height() + m_rows    - 1) / m_rows   );
+
+    auto for_each_cell_of = [this, &geo](std::size_t i, auto && f) {
+        auto low  = geo.offset_of(i) - m_origin;
+        auto high = low + Vector(geo.width[i] - 1, geo.height[i] - 1);
+        for (int row = low.y / m_cell_size.height; row <= high.y / m_cell_size.height; ++row) {
+        for (int col = low.x / m_cell_size.width ; col <= high.x / m_cell_size.width ; ++col) {
+            f(std::size_t(row*m_columns + col));
+        }}
+    };
+    m_cell_starts.assign(std::size_t(m_columns*m_rows) + 1, 0);
+    for (std::size_t i = 0; i != geo.size(); ++i) {
+        if (!is_hit(i)) continue;
+        for_each_cell_of(i, [this](std::size_t cell) { ++m_cell_starts[cell + 1]; });
+    }
+    std::partial_sum(m_cell_starts.begin(), m_cell_starts.end(), m_cell_starts.begin());
+    m_entries.resize(m_cell_starts.back());
+    auto ends = m_cell_starts;
+    for (std::size_t i = 0; i != geo.size(); ++i) {
+        if (!is_hit(i)) continue;
+        for_each_cell_of(i, [this, &ends, i](std::size_t cell) { m_entries[ends[cell]++] = i; });
+    }
+}
+
+void BareFrame::ChildHitGrid::clear() {
+    m_columns = m_rows = 0;
+    m_cell_starts.clear();
+    m_entries.clear();
+    m_is_built = false;
+}
+
+void BareFrame::ChildHitGrid::find_children_at
+    (const ChildGeometry & geo, Vector r, std::vector<std::size_t> & hits) const
+{
+    if (m_columns == 0) return;
+    auto from_origin = r - m_origin;
+    if (from_origin.x < 0 || from_origin.y < 0) return;
+    int column = from_origin.x / m_cell_size.width;
+    int row    = from_origin.y / m_cell_size.height;
+    if (column >= m_columns || row >= m_rows) return;
+    auto cell = std::size_t(row*m_columns + column);
+    for (auto itr = m_cell_starts[cell]; itr != m_cell_starts[cell + 1]; ++itr) {
+        auto idx = m_entries[itr];
+        if (is_contained_in(r, cul::compose(geo.offset_of(idx), geo.size_of(idx)))) {
+            hits.push_back(idx);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
 /* protected */ BareFrame::BareFrame() {
     // constructor needs to be very careful, many methods rely on decoration()
     // which at this point, that further derived "shell" of the instance hasn't
@@ -216,7 +375,13 @@ void WidgetAdder::swap(WidgetAdder & rhs) {
 }
 
 /* protected */ BareFrame::BareFrame(const BareFrame & lhs):
-    m_padding(lhs.m_padding)
+    m_padding(lhs.m_padding),
+    m_incremental_layout(lhs.m_incremental_layout),
+    m_relative_placement(lhs.m_relative_placement),
+    m_parallel_layout(lhs.m_parallel_layout),
+    m_grid_columns(lhs.m_grid_columns),
+    m_grid_rows(lhs.m_grid_rows),
+    m_pointer_hit_testing(lhs.m_pointer_hit_testing)
 {}
 
 /* protected */ BareFrame::BareFrame(BareFrame && lhs)
@@ -226,36 +391,87 @@ void WidgetAdder::swap(WidgetAdder & rhs) {
 
 /* protected */ void BareFrame::set_location_(int x, int y) {
     Vector delta = Vector(x, y) - location();
+    if (delta != Vector()) m_needs_redraw = m_needs_full_redraw = true;
+    if (   delta == Vector() && m_widget_extremes != WidgetBoundsFinder()
+        && !needs_whole_family_geometry_update())
+    {
+        // nothing is moving, so only those that asked need their geometry
+        // updated
+        update_flagged_individuals();
+        return;
+    }
     decoration().set_location(x, y);
 
     if (m_widget_extremes == WidgetBoundsFinder()) {
-        for (auto * widget_ptr : m_widgets) {
-            assert(widget_ptr);
-            auto loc = widget_ptr->location();
-            widget_ptr->set_location(loc.x + delta.x, loc.y + delta.y);
+        if (!m_relative_placement) {
+            for (auto * widget_ptr : m_widgets) {
+                assert(widget_ptr);
+                auto loc = widget_ptr->location();
+                widget_ptr->set_location(loc.x + delta.x, loc.y + delta.y);
+            }
         }
-        m_widget_extremes = BareFrame::get_measurements(m_widget_placements);
-        m_widget_placements.clear();
+        m_widget_extremes.set_to_zero();
+    } else if (m_child_geometry.size() != m_widgets.size()) {
+        // widgets have changed since the last size update
+        int width_for_widgets = m_widget_extremes.recorded_width();
+        measure_children();
+        if (has_grid_layout()) {
+            m_widget_extremes = place_into_grid
+                (width_for_widgets, m_widget_extremes.recorded_height());
+        } else {
+            break_into_lines(m_child_geometry, width_for_widgets, m_padding);
+            fill_lines(m_child_geometry, width_for_widgets, m_padding);
+            m_widget_extremes = BareFrame::get_measurements(m_child_geometry);
+        }
+        place_measured_children(false);
+    } else if (!m_relative_placement) {
+        place_measured_children(false);
     } else {
-        get_widget_placements(m_widget_placements, m_widget_extremes.recorded_width());
-        m_widget_extremes = BareFrame::get_measurements(m_widget_placements);
-        do_placements(m_widget_placements);
+        // children stay where they are relative to this frame, but those
+        // which asked still need their geometry updated
+        update_flagged_individuals();
     }
 
     check_invarients();
 }
 
 /* protected */ void BareFrame::draw_widgets(WidgetRenderer & target) const {
+    m_needs_redraw = m_needs_full_redraw = false;
+    m_dirty_regions.clear();
+    auto old_translation = target.translation();
+    if (m_relative_placement) {
+        target.set_translation(old_translation + decoration().widget_start());
+    }
     for (const auto * widget_ptr : m_widgets) {
         widget_ptr->draw(target);
     }
+    target.set_translation(old_translation);
 }
 
 void BareFrame::process_event(const Event & event) {
+    bool was_dragged = decoration().is_being_dragged();
     auto gv = decoration().process_event(event);
+    if (was_dragged != decoration().is_being_dragged()) {
+        if (was_dragged) receive_pointer_release(this);
+        else             receive_pointer_capture(this);
+    }
     if (!gv.skip_other_events) {
-        for (Widget * widget_ptr : m_widgets) {
-            widget_ptr->process_event(event);
+        const auto & child_event = m_relative_placement
+            ? translate_mouse_location(event, Vector() - decoration().widget_start())
+            : event;
+        const auto * pointer = mouse_location_of(child_event);
+        if (pointer && m_pointer_captor) {
+            // the release ending a drag also ends the press which started it
+            if (event.is_type<MouseRelease>()) {
+                m_pressed_children.clear();
+                m_pointer_pressed_inside = false;
+            }
+            if (m_pointer_captor != this)
+                { m_pointer_captor->process_event(child_event); }
+        } else if (!pointer || !m_pointer_hit_testing) {
+            send_event_to_subscribers(child_event);
+        } else if (pointer_reaches_children(event)) {
+            send_pointer_event(child_event, *pointer);
         }
         // perhaps I should process focus requests after the fact to give
         // widgets the opportunity to make a request after an event
@@ -275,9 +491,62 @@ void BareFrame::stylize(const StyleMap & smap) {
     check_invarients();
 }
 
+void BareFrame::receive_pointer_capture(Widget * widget) {
+    if (!widget) {
+        throw InvArg("BareFrame::receive_pointer_capture: widget pointer must "
+                     "not be null.");
+    }
+    // dropped widgets are never sent events from here
+    if (widget != this && !has_adopted(widget)) return;
+    m_pointer_captor = widget;
+    // frames above only need to know to send pointer events here
+    pass_up_pointer_capture(true);
+}
+
+void BareFrame::receive_pointer_release(Widget * widget) {
+    if (!widget || widget != m_pointer_captor) return;
+    m_pointer_captor = nullptr;
+    pass_up_pointer_capture(false);
+}
+
+void BareFrame::receive_redraw_needed(Widget * widget) {
+    if (!widget) {
+        throw InvArg("BareFrame::receive_redraw_needed: widget pointer must "
+                     "not be null.");
+    }
+    receive_region_redraw_needed(widget->bounds());
+}
+
+void BareFrame::receive_region_redraw_needed(const Rectangle & region) {
+    static constexpr const std::size_t k_max_dirty_regions = 16;
+    m_needs_redraw = true;
+    // regions are kept as this frame's owner sees them
+    auto owner_region = region;
+    if (m_relative_placement) {
+        owner_region.left += decoration().widget_start().x;
+        owner_region.top  += decoration().widget_start().y;
+    }
+    if (!m_needs_full_redraw) {
+        if (m_dirty_regions.size() == k_max_dirty_regions) {
+            // at some point it's just simpler to redraw everything
+            m_needs_full_redraw = true;
+            m_dirty_regions.clear();
+        } else {
+            m_dirty_regions.push_back(owner_region);
+        }
+    }
+    pass_up_region_redraw_needed(owner_region);
+}
+
+void BareFrame::receive_focus_receivers_changed() {
+    m_focus_receivers_changed = true;
+    pass_up_focus_receivers_changed();
+}
+
 Vector BareFrame::location() const {
     auto deco_loc = decoration().location();
-    auto ex_loc = m_widget_extremes.recorded_location();
+    if (m_widget_extremes == WidgetBoundsFinder()) return deco_loc;
+    auto ex_loc = decoration().widget_start() + m_widget_extremes.recorded_location();
     return Vector(std::min(deco_loc.x, ex_loc.x), std::min(deco_loc.y, ex_loc.y));
 }
 
@@ -292,8 +561,17 @@ WidgetAdder BareFrame::begin_adding_widgets() {
 #   if 0
     return WidgetAdder(this, &m_the_line_seperator);
 #   endif
+    // hovered widgets would otherwise never see the pointer leave
+    release_hover();
+    // old widgets may already be destroyed, so they're not touched, any
+    // still naming this frame as their owner are no longer adopted by it
+    m_adopted.clear();
     m_widgets.clear();
     m_horz_spacers.clear();
+    route_child_events();
+    // whatever had the pointer is no longer here
+    if (m_pointer_captor && m_pointer_captor != this)
+        { receive_pointer_release(m_pointer_captor); }
     return WidgetAdderAttn::make_adder
         (this, &m_the_line_seperator, std::move(m_widgets), std::move(m_horz_spacers));
 }
@@ -310,21 +588,32 @@ void BareFrame::finalize_widgets(std::vector<Widget *> && widgets,
 
     m_widgets     .swap(widgets);
     m_horz_spacers.swap(spacers);
+    m_child_geometry.clear();
+    m_hit_grid.clear();
+    // (by index) these may no longer be the same widgets
+    m_hovered_children.clear();
+    m_pressed_children.clear();
+    m_pointer_was_inside = true;
+
+    // this frame may have since been dropped by its owner, and must not
+    // keep sending it flags (say if that owner is about to be added here)
+    const BareFrame * owning_frame = owner() ? owner()->as_frame() : nullptr;
+    if (owning_frame && !owning_frame->has_adopted(this))
+        { assign_flags_receiver(nullptr); }
 
     static constexpr const char * k_cannot_contain_this =
         "Frame::finalize_widgets: This frame may not contain itself.";
-    if (contains(this)) throw InvArg(k_cannot_contain_this);
+    if (has_lineage_among(m_widgets)) throw InvArg(k_cannot_contain_this);
 
-    // note this marks this instance as a widget which "owns itself"
-    assign_flags_receiver(this);
-    iterate_children_f([this](Widget & widget) {
-        widget.assign_flags_receiver(this);
-        if (auto * frame = dynamic_cast<BareFrame *>(&widget)) {
-            frame->decoration().inform_is_child();
-        }
-    });
+    m_adopted.clear();
+    for (auto * widget : m_widgets) adopt(*widget);
+    std::sort(m_adopted.begin(), m_adopted.end(), std::less<const Widget *>());
+    route_child_events();
+    notify_readded_hover_left();
+    receive_focus_receivers_changed();
 
-    flag_needs_whole_family_geometry_update();
+    // flagged by this frame itself, so that every child is re-measured
+    receive_subtree_update_needed(this);
     check_invarients();
 }
 
@@ -337,69 +626,268 @@ void BareFrame::reset_register_click_event()
 void BareFrame::set_padding(int pixels)
     { m_padding = pixels; }
 
+void BareFrame::set_incremental_layout(bool b) {
+    m_incremental_layout = b;
+    iterate_children_f([b](Widget & widget) {
+        if (auto * frame = widget.as_frame()) {
+            frame->m_incremental_layout = b;
+        }
+    });
+}
+
+void BareFrame::set_relative_placement(bool b) {
+    if (m_relative_placement == b) return;
+    m_relative_placement = b;
+    // every widget needs to be placed again
+    receive_whole_family_upate_needed();
+}
+
+void BareFrame::set_parallel_layout(bool b)
+    { m_parallel_layout = b; }
+
+void BareFrame::set_grid_layout
+    (std::vector<GridTrack> && columns, std::vector<GridTrack> && rows)
+{
+    if (columns.empty()) {
+        throw InvArg("BareFrame::set_grid_layout: grid must have at least one "
+                     "column.");
+    }
+    m_grid_columns.swap(columns);
+    m_grid_rows.swap(rows);
+    // the last layout no longer applies, even if no child changes size
+    m_child_geometry.clear();
+    receive_whole_family_upate_needed();
+}
+
+void BareFrame::set_pointer_hit_testing(bool b) {
+    m_pointer_hit_testing = b;
+    m_pointer_was_inside = true;
+    iterate_children_f([b](Widget & widget) {
+        if (auto * frame = widget.as_frame()) {
+            frame->set_pointer_hit_testing(b);
+        }
+    });
+}
+
+void BareFrame::set_line_layout() {
+    if (!has_grid_layout()) return;
+    m_grid_columns.clear();
+    m_grid_rows.clear();
+    m_child_geometry.clear();
+    receive_whole_family_upate_needed();
+}
+
 void BareFrame::check_for_geometry_updates() {
+    if (m_open_layout_batches > 0) return;
     if (needs_whole_family_geometry_update()) {
+        m_needs_redraw = m_needs_full_redraw = true;
         update_size();
-        if (!decoration().is_child()) {
-            // v we don't need this below on a regular geometry update v
-            Widget & as_widget = *this;
-            // sadly I can't reveal (all of) the children of this frame without
-            // passing this, or incurring a dynamic allocation cost (micro optimizing?)
-
-            // I can try a give and take sort of deal if I *really* want to, that could
-            // avoid a use of "this"
-            m_focus_handler.check_for_child_widget_updates(as_widget);
-            // ^ we don't need this below on a regular geometry update ^
-        }
+    } else {
+        if (has_flagged_individuals())
+            { m_needs_redraw = m_needs_full_redraw = true; }
+        update_flagged_individuals();
+    }
+    if (m_focus_receivers_changed && !decoration().is_child()) {
+        // v we don't need this below on a regular geometry update v
+        m_focus_receivers_changed = false;
+        Widget & as_widget = *this;
+        // sadly I can't reveal (all of) the children of this frame without
+        // passing this, or incurring a dynamic allocation cost (micro optimizing?)
+
+        // I can try a give and take sort of deal if I *really* want to, that could
+        // avoid a use of "this"
+        m_focus_handler.check_for_child_widget_updates(as_widget);
+        // ^ we don't need this below on a regular geometry update ^
     }
-    unset_flags();
 }
 
+LayoutBatch BareFrame::begin_layout_batch()
+    { return LayoutBatch(*this); }
+
 void BareFrame::draw(WidgetRenderer & target) const {
     decoration().draw(target);
     draw_widgets(target);
 }
 
-void BareFrame::get_widget_placements(WidgetPlacementVector & vec, const int k_horz_space) const {
-    vec.reserve(m_widgets.size());
-    vec.clear();
+void BareFrame::swap(BareFrame & lhs) {
+    std::swap(m_padding, lhs.m_padding);
+    std::swap(m_incremental_layout, lhs.m_incremental_layout);
+    std::swap(m_relative_placement, lhs.m_relative_placement);
+    std::swap(m_parallel_layout, lhs.m_parallel_layout);
+    m_grid_columns.swap(lhs.m_grid_columns);
+    m_grid_rows.swap(lhs.m_grid_rows);
+    std::swap(m_pointer_hit_testing, lhs.m_pointer_hit_testing);
+}
 
-    class WidgetPlacer final : public PartialWidgetPlacerAdapter {
-    public:
-        void on_line_end(int, int) final {}
-        void operator () (Widget * widget_ptr, int x, int y) const final {
-            assert(!dynamic_cast<LineSeperator *>(widget_ptr));
-            assert(dest && widget_ptr);
-            dest->emplace_back(widget_ptr, Vector(x, y) + start);
-        }
+/* private */ bool BareFrame::is_horizontal_spacer
+    (const Widget * widget) const noexcept
+{
+    if (m_horz_spacers.empty()) return false;
+    return    widget >= &m_horz_spacers.front()
+           && widget <= &m_horz_spacers.back ();
+}
 
-        WidgetPlacementVector * dest = nullptr;
-        Vector start;
-    };
+/* private */ void BareFrame::open_layout_batch() {
+    ++m_open_layout_batches;
+    hold_flags();
+}
 
-    WidgetPlacer placer;
-    placer.assign_line_seperator(m_the_line_seperator);
-    placer.assign_horizontal_spacers_vector(m_horz_spacers);
-    placer.dest = &vec;
-    placer.start = decoration().widget_start();
+/* private */ void BareFrame::end_layout_batch(bool update_geometry) {
+    --m_open_layout_batches;
+    release_flags();
+    // a child frame is updated along with its parent (which has now been
+    // flagged if needed)
+    if (   !update_geometry || m_open_layout_batches > 0
+        || decoration().is_child())
+    { return; }
+    check_for_geometry_updates();
+}
 
-    run_placer_algo(placer, m_widgets, k_horz_space, m_padding);
+/* private */ bool BareFrame::has_lineage_among
+    (const std::vector<Widget *> & widgets) const
+{
+    // walking up is only as long as this frame is deep, where walking down
+    // through every widget could be the whole tree
+    std::vector<const Widget *> lineage;
+    for (const Widget * widget = this; widget; ) {
+        lineage.push_back(widget);
+        const Widget * owner = widget->owner();
+        // a frame which has since dropped this widget is no ancestor
+        const BareFrame * owning_frame = owner ? owner->as_frame() : nullptr;
+        if (owning_frame && !owning_frame->has_adopted(widget)) break;
+        widget = owner;
+    }
+    std::sort(lineage.begin(), lineage.end(), std::less<const Widget *>());
+    return std::any_of(widgets.begin(), widgets.end(),
+        [&lineage](const Widget * widget)
+    {
+        return std::binary_search(lineage.begin(), lineage.end(), widget,
+                                  std::less<const Widget *>());
+    });
 }
 
-void BareFrame::swap(BareFrame & lhs) {
-    std::swap(m_padding, lhs.m_padding);
+/* private */ void BareFrame::adopt(Widget & widget) {
+    widget.assign_flags_receiver(this);
+    m_adopted.push_back(&widget);
+    if (auto * frame = widget.as_frame()) {
+        frame->decoration().inform_is_child();
+        if (m_incremental_layout) frame->set_incremental_layout(true);
+        if (m_pointer_hit_testing) frame->set_pointer_hit_testing(true);
+    }
+    // other receivers (like nested frames) have already adopted their own
+    // children, flags sent to them will make their way up here
+    if (widget.as_flags_receiver()) return;
+    widget.iterate_children_f([this](Widget & child) { adopt(child); });
 }
 
-/* private */ bool BareFrame::contains(const Widget * wptr) const noexcept {
-    for (const auto * widget : m_widgets) {
-        if (widget == wptr) return true;
-        if (const auto * frame = dynamic_cast<const BareFrame *>(widget)) {
-            if (frame->contains(wptr)) return true;
-        }
+/* private */ bool BareFrame::has_adopted(const Widget * widget) const {
+    return std::binary_search(m_adopted.begin(), m_adopted.end(), widget,
+                              std::less<const Widget *>());
+}
+
+/* private */ bool BareFrame::update_child_sizes() {
+    take_whole_family_flags(m_flagged_subtrees);
+    bool was_measured =    m_widget_extremes != WidgetBoundsFinder()
+                        && m_child_geometry.size() == m_widgets.size();
+    // this frame flagging only itself (say it's being dragged) cannot have
+    // changed the size of any child
+    bool only_self_flagged = m_flagged_subtrees.size() == 1 && is_flagged(this);
+    // anything else flagging (a widget nested in a child which is not a
+    // frame) requires everyone to be re-measured
+    if (   was_measured
+        && (only_self_flagged || (m_incremental_layout && only_children_flagged())))
+    {
+        update_sizes_of_children(true);
+        return true;
     }
+    update_sizes_of_children(false);
     return false;
 }
 
+/* private */ void BareFrame::update_sizes_of_children(bool only_flagged) {
+    // child frames are set aside to be laid out together
+    std::vector<BareFrame *> frames;
+    for (auto * widget : m_widgets) {
+        assert(widget);
+        if (only_flagged && !is_flagged(widget)) continue;
+        if (m_parallel_layout) {
+            if (auto * frame = widget->as_frame()) {
+                frames.push_back(frame);
+                continue;
+            }
+        }
+        widget->update_size();
+    }
+    if (frames.size() < 2) {
+        for (auto * frame : frames) frame->update_size();
+        return;
+    }
+
+    // flags raised while laying out (including redraws, focus receiver
+    // changes and pointer captures) must not reach this frame from other
+    // threads, they are kept by each child until all are done
+    for (auto * frame : frames) frame->hold_flags();
+    std::vector<std::exception_ptr> errors(frames.size());
+    LayoutThreadPool::instance().run_each(frames.size(),
+        [&frames, &errors](std::size_t idx)
+    {
+        try {
+            Widget & as_widget = *frames[idx];
+            as_widget.update_size();
+        } catch (...) {
+            errors[idx] = std::current_exception();
+        }
+    });
+    for (auto * frame : frames) frame->release_flags();
+    for (auto & error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+/* private */ bool BareFrame::children_kept_sizes() const {
+    if (   m_widget_extremes == WidgetBoundsFinder()
+        || m_child_geometry.size() != m_widgets.size())
+    { return false; }
+    if (m_flagged_subtrees.size() == 1 && is_flagged(this)) return true;
+    const auto & geo = m_child_geometry;
+    static constexpr const uint8_t k_not_measured =
+        ChildGeometry::k_spacer | ChildGeometry::k_line_seperator;
+    for (std::size_t i = 0; i != geo.size(); ++i) {
+        if (geo.flags[i] & k_not_measured) continue;
+        if (geo.widgets[i]->size() != geo.size_of(i)) return false;
+    }
+    return true;
+}
+
+/* private */ bool BareFrame::is_flagged(const Widget * widget) const {
+    return std::binary_search(m_flagged_subtrees.begin(),
+        m_flagged_subtrees.end(), widget, std::less<const Widget *>());
+}
+
+/* private */ bool BareFrame::only_children_flagged() const {
+    auto flagged_children = std::count_if(m_widgets.begin(), m_widgets.end(),
+        [this](const Widget * widget) { return is_flagged(widget); });
+    if (is_flagged(this)) ++flagged_children;
+    return std::size_t(flagged_children) == m_flagged_subtrees.size();
+}
+
+/* private */ bool BareFrame::decoration_kept_constraints() {
+    auto & deco = decoration();
+    if (m_last_inputs.padding != m_padding) return false;
+    // lines only broken by seperators are the same at any width they fit in
+    // (children kept their sizes, so content widths are still good)
+    int available_width = deco.maximum_width_for_widgets();
+    int max_content_width = m_content_widths.maximum;
+    if (   m_last_inputs.available_width != available_width
+        && (   has_grid_layout()
+            || max_content_width > available_width
+            || max_content_width > m_last_inputs.available_width))
+    { return false; }
+    const auto & requested = m_last_inputs.requested_size;
+    return    deco.request_size(requested.width, requested.height)
+           == m_last_inputs.accepted_size;
+}
+
 /* private */ void BareFrame::iterate_children_(const ChildWidgetIterator & itr) {
     for (auto * widget : m_widgets) {
         itr(*widget);
@@ -417,42 +905,169 @@ void BareFrame::swap(BareFrame & lhs) {
 }
 
 /* private */ void BareFrame::update_size() {
-    for (auto * widget : m_widgets) {
-        assert(widget);
-        widget->update_size();
+    // flags are kept until the batch ends
+    if (m_open_layout_batches > 0) return;
+    bool only_flagged_updated = update_child_sizes();
+    if (children_kept_sizes() && decoration_kept_constraints()) {
+        // the lines remain exactly as they were, flagged widgets only need
+        // to be re-placed where they already are, unless the decoration
+        // moved where widgets start
+        if (children_origin() != m_last_inputs.origin) {
+            place_measured_children(false);
+        } else {
+            for (auto * widget : m_flagged_subtrees) {
+                if (widget == this) continue;
+                auto loc = widget->location();
+                widget->set_location(loc.x, loc.y);
+            }
+        }
+        m_flagged_subtrees.clear();
+        update_flagged_individuals();
+        return;
     }
 
+    // every child is measured exactly once, everything from here on works
+    // from those measurements
+    ++m_layout_count;
+    measure_children();
+    auto widget_extremes = has_grid_layout() ? lay_out_grid() : lay_out_lines();
+
+    // last updates
+    m_widget_extremes = widget_extremes;
+    place_measured_children(only_flagged_updated);
+    m_flagged_subtrees.clear();
+    update_flagged_individuals();
+}
+
+/* private */ BareFrame::WidgetBoundsFinder BareFrame::lay_out_lines() {
     auto & deco = decoration();
-    // place without spacers
-    {
+    // place without spacers (which are measured as having no width)
     int available_width = deco.maximum_width_for_widgets();
-    // some widgets may change size...
-    for (auto & spacer : m_horz_spacers) spacer.set_width(0);
-    get_widget_placements(m_widget_placements, available_width);
+    break_into_lines(m_child_geometry, available_width, m_padding);
+
+    // redo placement adjusted for minimum needed width, lines which were
+    // never too long come out the same at any width they fit in
+    WidgetBoundsFinder widget_extremes = BareFrame::get_measurements(m_child_geometry);
+    bool lines_unbroken =    m_content_widths.maximum <= available_width
+                          && m_content_widths.maximum == widget_extremes.recorded_width();
+    if (!lines_unbroken && widget_extremes.recorded_width() != available_width) {
+        break_into_lines(m_child_geometry, widget_extremes.recorded_width(), m_padding);
     }
-
-    // redo placement adjusted for minimum needed width
-    WidgetBoundsFinder widget_extremes = BareFrame::get_measurements(m_widget_placements);
-    update_horizontal_spacers(widget_extremes.recorded_width());
-    get_widget_placements(m_widget_placements, widget_extremes.recorded_width());
+    fill_lines(m_child_geometry, widget_extremes.recorded_width(), m_padding);
 
     // request size (padding needs to be included)
     int requested_width = widget_extremes.recorded_width();
     auto accepted_size = deco.request_size
         (requested_width, widget_extremes.recorded_height());
+    m_last_inputs.padding         = m_padding;
+    m_last_inputs.available_width = available_width;
+    m_last_inputs.requested_size  = Size(requested_width, widget_extremes.recorded_height());
+    m_last_inputs.accepted_size   = accepted_size;
 
     // if the request failed, we end up having to play by the frame
     // decorations' rules
     if (accepted_size.width != requested_width) {
         int width_for_widgets = accepted_size.width;
-        update_horizontal_spacers(width_for_widgets);
-        get_widget_placements(m_widget_placements, width_for_widgets);
-        widget_extremes = BareFrame::get_measurements(m_widget_placements);
+        // lines are broken again either way, those wrapped at a narrower
+        // width may fit together at a wider one, with spacers keeping their
+        // widths until refilled
+        break_into_lines(m_child_geometry, width_for_widgets, m_padding);
+        fill_lines(m_child_geometry, width_for_widgets, m_padding);
+        break_into_lines(m_child_geometry, width_for_widgets, m_padding);
+        widget_extremes = BareFrame::get_measurements(m_child_geometry);
     }
 
-    // last updates
-    m_widget_extremes = widget_extremes;
-    do_placements(m_widget_placements);
+    return widget_extremes;
+}
+
+/* private */ BareFrame::WidgetBoundsFinder BareFrame::lay_out_grid() {
+    static constexpr const int k_no_limit = FrameDecoration::k_no_width_limit_for_widgets;
+    auto & deco = decoration();
+    int available_width = deco.maximum_width_for_widgets();
+    auto widget_extremes = place_into_grid(available_width, k_no_limit);
+
+    Size requested_size(widget_extremes.recorded_width(), widget_extremes.recorded_height());
+    auto accepted_size = deco.request_size(requested_size.width, requested_size.height);
+    m_last_inputs.padding         = m_padding;
+    m_last_inputs.available_width = available_width;
+    m_last_inputs.requested_size  = requested_size;
+    m_last_inputs.accepted_size   = accepted_size;
+
+    // fractional tracks take up (or give up) whatever space the decoration
+    // decided on
+    if (accepted_size != requested_size) {
+        widget_extremes = place_into_grid(accepted_size.width, accepted_size.height);
+    }
+    return widget_extremes;
+}
+
+/* private */ BareFrame::WidgetBoundsFinder BareFrame::place_into_grid
+    (int width_for_widgets, int height_for_widgets)
+{
+    auto & geo = m_child_geometry;
+    // cells are taken row by row, finding the largest widget of each track
+    // along the way, cells are kept in offsets until tracks are sized
+    std::vector<int> column_sizes(m_grid_columns.size(), 0);
+    std::vector<int> row_sizes;
+    std::size_t column = 0;
+    std::size_t row = 0;
+    for (std::size_t i = 0; i != geo.size(); ++i) {
+        if (geo.has(i, ChildGeometry::k_line_seperator)) {
+            geo.x[i] = geo.y[i] = 0;
+            if (column != 0) {
+                column = 0;
+                ++row;
+            }
+            continue;
+        }
+        if (column == column_sizes.size()) {
+            column = 0;
+            ++row;
+        }
+        if (row == row_sizes.size()) row_sizes.push_back(0);
+        geo.x[i] = int(column);
+        geo.y[i] = int(row);
+        if (!geo.has(i, ChildGeometry::k_spacer)) {
+            column_sizes[column] = std::max(column_sizes[column], geo.width [i]);
+            row_sizes   [row   ] = std::max(row_sizes   [row   ], geo.height[i]);
+        }
+        ++column;
+    }
+
+    WidgetBoundsFinder grid_bounds;
+    if (row_sizes.empty()) {
+        grid_bounds.set_to_zero();
+        return grid_bounds;
+    }
+    size_grid_tracks(m_grid_columns, column_sizes, width_for_widgets , m_padding);
+    size_grid_tracks(m_grid_rows   , row_sizes   , height_for_widgets, m_padding);
+
+    // tracks' sizes become their starts
+    auto to_track_starts = [this](std::vector<int> & sizes) {
+        int start = 0;
+        for (auto & size : sizes) {
+            int next_start = start + size + m_padding;
+            size  = start;
+            start = next_start;
+        }
+        return start - m_padding;
+    };
+    std::vector<int> column_widths = column_sizes;
+    int grid_width  = to_track_starts(column_sizes);
+    int grid_height = to_track_starts(row_sizes);
+    for (std::size_t i = 0; i != geo.size(); ++i) {
+        if (geo.has(i, ChildGeometry::k_line_seperator)) continue;
+        auto cell_column = std::size_t(geo.x[i]);
+        if (geo.has(i, ChildGeometry::k_spacer)) {
+            // spacers fill out their cells
+            geo.width[i] = column_widths[cell_column];
+            static_cast<HorizontalSpacer *>(geo.widgets[i])->set_width(geo.width[i]);
+        }
+        geo.x[i] = column_sizes[cell_column];
+        geo.y[i] = row_sizes[std::size_t(geo.y[i])];
+    }
+    grid_bounds.record_widget_bounds(Vector(), Size(grid_width, grid_height));
+    return grid_bounds;
 }
 
 /* private */ void BareFrame::check_invarients() const {
@@ -462,36 +1077,252 @@ void BareFrame::swap(BareFrame & lhs) {
 #   endif
 }
 
-/* private */ void BareFrame::update_horizontal_spacers(const int k_horz_space) {
-    // k_horz_space describes the amount of space available for widgets
-    assert(k_horz_space != FrameDecoration::k_no_width_limit_for_widgets);
+/* private */ void BareFrame::measure_children() {
+    // children are about to be laid out again
+    m_hit_grid.clear();
+    m_child_geometry.clear();
+    m_child_geometry.reserve(m_widgets.size());
+    for (auto * widget : m_widgets) {
+        assert(widget);
+        // spacers' widths are determined by the lines they are placed on
+        if (widget == &m_the_line_seperator) {
+            m_child_geometry.push_back(widget, Size(), ChildGeometry::k_line_seperator);
+        } else if (is_horizontal_spacer(widget)) {
+            m_child_geometry.push_back(widget, Size(), ChildGeometry::k_spacer);
+        } else {
+            m_child_geometry.push_back(widget, widget->size(), 0);
+        }
+    }
+    m_content_widths = find_content_widths(m_child_geometry, m_padding);
+}
+
+/* private */ void BareFrame::send_pointer_event
+    (const Event & event, const MouseLocation & pointer)
+{
+    auto & targets = m_pointer_targets;
+    targets.clear();
+    if (   m_widget_extremes == WidgetBoundsFinder()
+        || m_child_geometry.size() != m_widgets.size())
+    {
+        // not laid out yet, so widgets are asked where they are
+        for (std::size_t idx = 0; idx != m_widgets.size(); ++idx) {
+            if (is_contained_in(pointer, m_widgets[idx]->bounds()))
+                { targets.push_back(idx); }
+        }
+    } else {
+        if (!m_hit_grid.is_built()) m_hit_grid.build(m_child_geometry);
+        m_hit_grid.find_children_at
+            (m_child_geometry, pointer - children_origin(), targets);
+        std::sort(targets.begin(), targets.end());
+    }
+    auto under_pointer_count = targets.size();
+    bool is_move = event.is_type<MouseMove>();
+    if (is_move) notify_hover_changes(under_pointer_count);
+    targets.insert(targets.end(), m_hovered_children.begin(), m_hovered_children.end());
+    targets.insert(targets.end(), m_pressed_children.begin(), m_pressed_children.end());
+    // only a move may leave a widget, presses and releases (which could be
+    // anywhere) leave hover as it was
+    switch (event.type_id()) {
+    case k_event_id_of<MouseMove>:
+        m_hovered_children.assign(targets.begin(), targets.begin() + under_pointer_count);
+        break;
+    case k_event_id_of<MousePress>:
+        m_pressed_children.assign(targets.begin(), targets.begin() + under_pointer_count);
+        break;
+    case k_event_id_of<MouseRelease>:
+        m_pressed_children.clear();
+        break;
+    default: break;
+    }
+
+    // widgets see events in the same order as they would otherwise
+    std::sort(targets.begin(), targets.end());
+    targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+    for (auto idx : targets) {
+        if (!child_handles(idx, event.type_id())) continue;
+        // these have already been told if the pointer entered or left
+        if (is_move && m_hover_only_children[idx]) continue;
+        m_widgets[idx]->process_event(event);
+    }
+}
+
+/* private */ void BareFrame::notify_hover_changes
+    (std::size_t under_pointer_count)
+{
+    // both hovered before and now are sorted, children in one and not the
+    // other are those which the pointer entered or left
+    auto old_itr = m_hovered_children.begin();
+    auto old_end = m_hovered_children.end();
+    auto new_itr = m_pointer_targets.begin();
+    auto new_end = new_itr + std::ptrdiff_t(under_pointer_count);
+    while (old_itr != old_end || new_itr != new_end) {
+        if (new_itr == new_end || (old_itr != old_end && *old_itr < *new_itr)) {
+            auto idx = *old_itr++;
+            if (m_hover_only_children[idx]) m_widgets[idx]->notify_hover_left();
+        } else if (old_itr == old_end || *new_itr < *old_itr) {
+            auto idx = *new_itr++;
+            if (m_hover_only_children[idx]) m_widgets[idx]->notify_hover_entered();
+        } else {
+            ++old_itr;
+            ++new_itr;
+        }
+    }
+}
 
-    HorizontalSpacerUpdater spacer_updater;
-    spacer_updater.assign_line_seperator(m_the_line_seperator);
-    spacer_updater.assign_horizontal_spacers_vector(m_horz_spacers);
-    spacer_updater.set_widget_iterators(m_widgets);
-    spacer_updater.set_horizontal_space(k_horz_space);
-    run_placer_algo(spacer_updater, m_widgets, k_horz_space, m_padding);
+/* private */ void BareFrame::release_hover() {
+    m_formerly_hovered.clear();
+    for (auto idx : m_hovered_children) {
+        if (m_hover_only_children[idx]) m_formerly_hovered.push_back(m_widgets[idx]);
+    }
+    m_hovered_children.clear();
+}
+
+/* private */ void BareFrame::notify_readded_hover_left() {
+    if (m_formerly_hovered.empty()) return;
+    std::sort(m_formerly_hovered.begin(), m_formerly_hovered.end(),
+              std::less<const Widget *>());
+    for (std::size_t idx = 0; idx != m_widgets.size(); ++idx) {
+        if (!m_hover_only_children[idx]) continue;
+        if (!std::binary_search(m_formerly_hovered.begin(), m_formerly_hovered.end(),
+                                m_widgets[idx], std::less<const Widget *>()))
+        { continue; }
+        m_widgets[idx]->notify_hover_left();
+    }
+    m_formerly_hovered.clear();
 }
 
+/* private */ bool BareFrame::pointer_reaches_children(const Event & event) {
+    const auto * pointer = mouse_location_of(event);
+    if (!pointer) return true;
+    // not laid out yet, so these bounds mean nothing
+    if (m_widget_extremes == WidgetBoundsFinder()) {
+        m_pointer_was_inside = true;
+        return true;
+    }
+    bool is_inside = is_contained_in(*pointer, bounds());
+    // children which last saw the pointer move inside still need to see it
+    // move out, and drags started inside may continue anywhere
+    bool reaches = is_inside || m_pointer_was_inside || m_pointer_pressed_inside;
+    switch (event.type_id()) {
+    case k_event_id_of<MouseMove>:
+        m_pointer_was_inside = is_inside;
+        break;
+    case k_event_id_of<MousePress>:
+        m_pointer_pressed_inside = is_inside;
+        break;
+    case k_event_id_of<MouseRelease>:
+        m_pointer_pressed_inside = false;
+        break;
+    default: break;
+    }
+    return reaches;
+}
+
+/* private */ void BareFrame::send_event_to_subscribers(const Event & event) {
+    auto type_id = event.type_id();
+    const auto & subscribers =
+        (type_id >= 0 && type_id < k_event_type_count)
+        ? m_event_routes[std::size_t(type_id)] : m_widgets;
+    for (auto * widget : subscribers) {
+        widget->process_event(event);
+    }
+}
+
+/* private */ void BareFrame::route_child_events() {
+    for (auto & route : m_event_routes) route.clear();
+    m_child_event_types.clear();
+    m_child_event_types.reserve(m_widgets.size());
+    m_hover_only_children.clear();
+    m_hover_only_children.reserve(m_widgets.size());
+    for (auto * widget : m_widgets) {
+        auto handled = widget->handled_event_types();
+        m_child_event_types.push_back(handled);
+        m_hover_only_children.push_back(widget->uses_moves_only_for_hover());
+        for (int type_id = 0; type_id != k_event_type_count; ++type_id) {
+            if (!(handled & (EventTypeMask(1) << EventTypeMask(type_id))))
+                continue;
+            m_event_routes[std::size_t(type_id)].push_back(widget);
+        }
+    }
+}
+
+/* private */ bool BareFrame::child_handles
+    (std::size_t child_index, int event_type_id) const
+{
+    if (event_type_id < 0 || event_type_id >= k_event_type_count) return true;
+    return m_child_event_types[child_index]
+        & (EventTypeMask(1) << EventTypeMask(event_type_id));
+}
+
+/* private */ void BareFrame::place_measured_children
+    (bool only_flagged_or_moving)
+{
+    auto start = children_origin();
+    const auto & geo = m_child_geometry;
+    for (std::size_t i = 0; i != geo.size(); ++i) {
+        if (geo.has(i, ChildGeometry::k_line_seperator)) continue;
+        auto * widget = geo.widgets[i];
+        auto loc = start + geo.offset_of(i);
+        if (   only_flagged_or_moving
+            && !is_flagged(widget) && widget->location() == loc)
+        { continue; }
+        widget->set_location(loc.x, loc.y);
+    }
+    m_last_inputs.origin = start;
+}
+
+/* private */ Vector BareFrame::children_origin() const
+    { return m_relative_placement ? Vector() : decoration().widget_start(); }
+
 /* private static */ BareFrame::WidgetBoundsFinder BareFrame::get_measurements
-    (const WidgetPlacementVector & widget_placements)
+    (const ChildGeometry & geo)
 {
     WidgetBoundsFinder widget_extremes;
-    if (widget_placements.empty()) {
+    auto is_placed = [](uint8_t flags)
+        { return (flags & ChildGeometry::k_line_seperator) == 0; };
+    if (std::none_of(geo.flags.begin(), geo.flags.end(), is_placed)) {
         widget_extremes.set_to_zero();
         return widget_extremes;
     }
-    for (auto [widget_ptr, loc] : widget_placements) {
+    for (std::size_t i = 0; i != geo.size(); ++i) {
         // the line seperator reports itself as being at the origin
         // regardless of placement, this can result in inaccurate bounds
-        assert(widget_ptr);
-        if (widget_ptr->size() == Size()) continue;
-        widget_extremes.record_widget_bounds(loc, *widget_ptr);
+        // spacers only ever take up space left over by other widgets
+        if (   (geo.width[i] == 0 && geo.height[i] == 0)
+            || geo.has(i, ChildGeometry::k_spacer))
+        { continue; }
+        widget_extremes.record_widget_bounds(geo.offset_of(i), geo.size_of(i));
     }
     return widget_extremes;
 }
 
+/* private static */ BareFrame::ContentWidths BareFrame::find_content_widths
+    (const ChildGeometry & geo, int padding_between_widgets)
+{
+    // much like break_into_lines, if no line were ever too long
+    ContentWidths widths;
+    int x = 0;
+    bool last_is_regular_widget = false;
+    for (std::size_t i = 0; i != geo.size(); ++i) {
+        if (geo.has(i, ChildGeometry::k_line_seperator)) {
+            x = 0;
+            last_is_regular_widget = false;
+            continue;
+        }
+        bool this_is_regular_widget = !geo.has(i, ChildGeometry::k_spacer);
+        if (this_is_regular_widget && last_is_regular_widget) {
+            x += padding_between_widgets;
+        }
+        last_is_regular_widget = this_is_regular_widget;
+        if (this_is_regular_widget) {
+            widths.minimum = std::max(widths.minimum, geo.width[i]);
+            x += geo.width[i];
+        }
+        widths.maximum = std::max(widths.maximum, x);
+    }
+    return widths;
+}
+
 // ----------------------------------------------------------------------------
 
 void Frame::set_title(const UString & str)
@@ -525,124 +1356,240 @@ SimpleFrame::~SimpleFrame() {}
 
 namespace {
 
-bool PartialWidgetPlacerAdapter::is_line_seperator(const Widget & widget) const {
-    assert(m_line_seperator);
-    return m_line_seperator == &widget;
-}
-
-bool PartialWidgetPlacerAdapter::is_horizontal_spacer
-    (const Widget & widget) const
-{
-    assert(m_spacers_vector);
-    if (m_spacers_vector->empty()) return false;
-    return    &widget >= &m_spacers_vector->front()
-           && &widget <= &m_spacers_vector->back ();
-}
-
-HorizontalSpacerUpdater::~HorizontalSpacerUpdater() {
-    // this is testing algorithm correctness
-    assert(m_horz_itr   == horizontal_spacers_end());
-    assert(m_widget_itr == m_widget_end);
-}
-
-void HorizontalSpacerUpdater::on_line_end
-    (int widgets_covered, int ns_width)
-{
-    auto horz_line_end = m_horz_itr;
-    for (; widgets_covered; --widgets_covered) {
-        assert(m_widget_itr != m_widget_end);
-        if (point_to_same(m_widget_itr, horz_line_end)) {
-            ++horz_line_end;
-        } else {
-            assert(!dynamic_cast<HorizontalSpacer *>(*m_widget_itr));
-        }
-        ++m_widget_itr;
-    }
-    if (m_horz_itr == horz_line_end) return;
-
-    int space_for_spacers = std::max(0, m_horz_space - ns_width);
-    int left_over_pixels  = space_for_spacers % (horz_line_end - m_horz_itr);
-    space_for_spacers /= (horz_line_end - m_horz_itr);
-    assert(space_for_spacers >= 0);
-    for (auto itr = m_horz_itr; itr != horz_line_end; ++itr) {
-        bool is_mid = itr == m_horz_itr + (horz_line_end - horz_line_end) / 2;
-        itr->set_width(space_for_spacers + (is_mid ? left_over_pixels : 0));
-    }
-
-    m_horz_itr = horz_line_end;
-}
-
-void HorizontalSpacerUpdater::assign_horizontal_spacers_vector
-    (std::vector<HorizontalSpacer> & vec)
-{
-    PartialWidgetPlacerAdapter::assign_horizontal_spacers_vector(vec);
-    m_horz_itr = vec.begin();
-}
-
-void HorizontalSpacerUpdater::set_widget_iterators
-    (const std::vector<Widget *> & widgets)
-{
-    m_widget_itr = widgets.begin();
-    m_widget_end = widgets.end();
-}
-
-void do_placements(WidgetPlacementVector & placements) {
-    for (auto [widget_ptr, loc] : placements) {
-        assert(widget_ptr);
-        widget_ptr->set_location(loc.x, loc.y);
-    }
-    placements.clear();
-}
-
-void run_placer_algo
-    (WidgetPlacerAdapter & placer, const std::vector<Widget *> & widgets,
-     int width_for_widgets, int padding_between_widgets)
+void break_into_lines
+    (ChildGeometry & geo, int width_for_widgets, int padding_between_widgets)
 {
     int x = 0;
     int y = 0;
-    int count = 0;
-    int ns_width = 0;
-
     int line_height = 0;
+    bool at_line_start = true;
     auto advance_to_next_line = [&, padding_between_widgets]() {
-        placer.on_line_end(count, ns_width);
         y += line_height + padding_between_widgets;
-        ns_width = x = count = line_height = 0;
+        x = line_height = 0;
+        at_line_start = true;
     };
 
     bool last_is_regular_widget = false;
-    for (Widget * widget_ptr : widgets) {
-        assert(widget_ptr);
-        if (placer.is_line_seperator(*widget_ptr)) {
+    for (std::size_t i = 0; i != geo.size(); ++i) {
+        if (geo.has(i, ChildGeometry::k_line_seperator)) {
             last_is_regular_widget = false;
             // we'll put the seperator on the line which it breaks
-            ++count;
+            geo.set(i, ChildGeometry::k_starts_line, at_line_start);
             advance_to_next_line();
             continue;
         }
-        auto widget_size = widget_ptr->size();
-        if (x != 0 && x + widget_size.width > width_for_widgets) {
+        if (x != 0 && x + geo.width[i] > width_for_widgets) {
             // horizontal overflow
             advance_to_next_line();
         }
         // intra widget padding
-        bool this_is_regular_widget = !placer.is_horizontal_spacer(*widget_ptr);
-        if (this_is_regular_widget && last_is_regular_widget) {
-            x        += padding_between_widgets;
-            ns_width += padding_between_widgets;
+        bool this_is_regular_widget = !geo.has(i, ChildGeometry::k_spacer);
+        bool padded = this_is_regular_widget && last_is_regular_widget;
+        geo.set(i, ChildGeometry::k_padded, padded);
+        if (padded) {
+            x += padding_between_widgets;
         }
         last_is_regular_widget = this_is_regular_widget;
 
         // placement and advance
-        placer(widget_ptr, x, y);
-        x += widget_size.width;
-        if (this_is_regular_widget) {
-            ns_width += widget_size.width;
+        geo.set(i, ChildGeometry::k_starts_line, at_line_start);
+        at_line_start = false;
+        geo.x[i] = x;
+        geo.y[i] = y;
+        x += geo.width[i];
+        line_height = std::max(line_height, geo.height[i]);
+    }
+}
+
+void fill_lines
+    (ChildGeometry & geo, int width_for_widgets, int padding_between_widgets)
+{
+    assert(width_for_widgets != asgl::FrameDecoration::k_no_width_limit_for_widgets);
+    std::size_t line_beg = 0;
+    while (line_beg != geo.size()) {
+        auto line_end = line_beg + 1;
+        while (   line_end != geo.size()
+               && !geo.has(line_end, ChildGeometry::k_starts_line))
+        { ++line_end; }
+
+        // width taken by non-spacers (including padding)
+        int ns_width = 0;
+        int spacer_count = 0;
+        for (auto i = line_beg; i != line_end; ++i) {
+            if (geo.has(i, ChildGeometry::k_line_seperator)) continue;
+            if (geo.has(i, ChildGeometry::k_padded)) ns_width += padding_between_widgets;
+            if (geo.has(i, ChildGeometry::k_spacer)) ++spacer_count;
+            else                                     ns_width += geo.width[i];
         }
-        line_height = std::max(line_height, widget_size.height);
-        ++count;
+
+        int space_for_spacers = 0;
+        int left_over_pixels  = 0;
+        if (spacer_count) {
+            space_for_spacers = std::max(0, width_for_widgets - ns_width);
+            left_over_pixels  = space_for_spacers % spacer_count;
+            space_for_spacers /= spacer_count;
+        }
+
+        int x = 0;
+        for (auto i = line_beg; i != line_end; ++i) {
+            if (geo.has(i, ChildGeometry::k_line_seperator)) continue;
+            if (geo.has(i, ChildGeometry::k_padded)) x += padding_between_widgets;
+            if (geo.has(i, ChildGeometry::k_spacer)) {
+                // first spacer on the line takes any left over pixels
+                geo.width[i] = space_for_spacers + left_over_pixels;
+                left_over_pixels = 0;
+                static_cast<HorizontalSpacer *>(geo.widgets[i])->set_width(geo.width[i]);
+            }
+            geo.x[i] = x;
+            x += geo.width[i];
+        }
+        line_beg = line_end;
+    }
+}
+
+void size_grid_tracks
+    (const std::vector<GridTrack> & tracks, std::vector<int> & sizes,
+     int available_space, int padding_between_tracks)
+{
+    auto track_at = [&tracks](std::size_t idx)
+        { return idx < tracks.size() ? tracks[idx] : GridTrack(); };
+    // space taken by everything other than fractional tracks
+    int used_space = padding_between_tracks*std::max(0, int(sizes.size()) - 1);
+    int total_parts = 0;
+    for (std::size_t i = 0; i != sizes.size(); ++i) {
+        auto track = track_at(i);
+        switch (track.sizing()) {
+        case GridTrack::k_fixed_sizing:
+            sizes[i] = track.amount();
+            break;
+        case GridTrack::k_fraction_sizing:
+            total_parts += track.amount();
+            continue;
+        case GridTrack::k_auto_sizing: break;
+        }
+        used_space += sizes[i];
+    }
+    if (total_parts == 0) return;
+
+    if (available_space == asgl::FrameDecoration::k_no_width_limit_for_widgets) {
+        // nothing to share, parts are as large as the track needing the
+        // largest part
+        int part_size = 0;
+        for (std::size_t i = 0; i != sizes.size(); ++i) {
+            auto track = track_at(i);
+            if (track.sizing() != GridTrack::k_fraction_sizing) continue;
+            part_size = std::max(part_size, (sizes[i] + track.amount() - 1) / track.amount());
+        }
+        for (std::size_t i = 0; i != sizes.size(); ++i) {
+            auto track = track_at(i);
+            if (track.sizing() != GridTrack::k_fraction_sizing) continue;
+            sizes[i] = part_size*track.amount();
+        }
+        return;
+    }
+
+    int left_over_space = std::max(0, available_space - used_space);
+    // first fractional track takes any left over pixels
+    int left_over_pixels = left_over_space;
+    for (std::size_t i = 0; i != sizes.size(); ++i) {
+        auto track = track_at(i);
+        if (track.sizing() != GridTrack::k_fraction_sizing) continue;
+        left_over_pixels -= int((long long)(left_over_space)*track.amount() / total_parts);
+    }
+    for (std::size_t i = 0; i != sizes.size(); ++i) {
+        auto track = track_at(i);
+        if (track.sizing() != GridTrack::k_fraction_sizing) continue;
+        int share = int((long long)(left_over_space)*track.amount() / total_parts)
+                    + left_over_pixels;
+        left_over_pixels = 0;
+        sizes[i] = std::max(sizes[i], share);
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+// threads running work for the pool (including a caller while it waits on its
+// run), frames laid out from these don't start nested runs
+thread_local bool t_is_running_layout_work = false;
+
+LayoutThreadPool::~LayoutThreadPool() {
+    {
+    std::unique_lock lock(m_mutex);
+    m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto & worker : m_workers) worker.join();
+}
+
+void LayoutThreadPool::run_each(std::size_t count, const IndexFunc & f) {
+    if (t_is_running_layout_work || m_workers.empty()) {
+        for (std::size_t i = 0; i != count; ++i) f(i);
+        return;
+    }
+    std::unique_lock run_lock(m_run_mutex);
+    {
+    std::unique_lock lock(m_mutex);
+    m_job   = &f;
+    m_count = count;
+    m_next_index = 0;
+    ++m_generation;
+    }
+    m_wake.notify_all();
+
+    take_indices(f, count);
+
+    std::unique_lock lock(m_mutex);
+    m_done.wait(lock, [this] { return m_active == 0; });
+    // workers yet to wake must not see this job
+    m_job = nullptr;
+}
+
+/* static */ LayoutThreadPool & LayoutThreadPool::instance() {
+    static LayoutThreadPool inst;
+    return inst;
+}
+
+/* private */ LayoutThreadPool::LayoutThreadPool() {
+    static constexpr const unsigned k_max_workers = 7;
+    auto hardware_threads = std::thread::hardware_concurrency();
+    // the caller of a run takes part as well
+    auto worker_count = std::min(hardware_threads > 1 ? hardware_threads - 1 : 0u,
+                                 k_max_workers);
+    m_workers.reserve(worker_count);
+    for (unsigned i = 0; i != worker_count; ++i) {
+        m_workers.emplace_back([this] { work(); });
+    }
+}
+
+/* private */ void LayoutThreadPool::work() {
+    std::size_t seen_generation = 0;
+    std::unique_lock lock(m_mutex);
+    while (true) {
+        m_wake.wait(lock, [this, &seen_generation] {
+            return m_stopping || (m_job && m_generation != seen_generation);
+        });
+        if (m_stopping) return;
+        seen_generation = m_generation;
+        const auto & job = *m_job;
+        auto count = m_count;
+        ++m_active;
+        lock.unlock();
+
+        take_indices(job, count);
+
+        lock.lock();
+        if (--m_active == 0) m_done.notify_all();
+    }
+}
+
+/* private */ void LayoutThreadPool::take_indices
+    (const IndexFunc & f, std::size_t count)
+{
+    t_is_running_layout_work = true;
+    for (auto idx = m_next_index++; idx < count; idx = m_next_index++) {
+        f(idx);
     }
-    if (count) advance_to_next_line();
+    t_is_running_layout_work = false;
 }
 
 } // end of <anonymous> namespace
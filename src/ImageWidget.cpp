@@ -43,13 +43,11 @@ SharedImagePtr ImageWidget::load_image
 { return (m_image = loader.make_image_resource(filename)); }
 
 void ImageWidget::set_image(SharedImagePtr resptr) {
+    Rectangle image_rect(0, 0, resptr->image_width(), resptr->image_height());
+    if (m_image == resptr && m_image_rect == image_rect) return;
     m_image = resptr;
-    m_image_rect = Rectangle(0, 0, m_image->image_width(), m_image->image_height());
-    // (don't delete quite yet?)
-    // it isn't clear to me how I should go about marking for needing redraw
-#   if 0
+    m_image_rect = image_rect;
     set_needs_redraw_flag();
-#   endif
 }
 
 void ImageWidget::copy_image_from(ImageLoader & loader, const ImageWidget & rhs)
@@ -67,27 +67,21 @@ void ProgressBar::stylize(const StyleMap & map) {
 }
 
 void ProgressBar::set_outer_style(StyleKey key) {
+    if (m_outer_key == key) return;
     m_outer_key = key;
-    // it isn't clear to me how I should go about marking for needing redraw
-#   if 0
     set_needs_redraw_flag();
-#   endif
 }
 
 void ProgressBar::set_fill_style(StyleKey key) {
+    if (m_fill_key == key) return;
     m_fill_key = key;
-    // it isn't clear to me how I should go about marking for needing redraw
-#   if 0
     set_needs_redraw_flag();
-#   endif
 }
 
 void ProgressBar::set_void_style(StyleKey key) {
+    if (m_void_key == key) return;
     m_void_key = key;
-    // it isn't clear to me how I should go about marking for needing redraw
-#   if 0
     set_needs_redraw_flag();
-#   endif
 }
 
 void ProgressBar::set_padding(int p) {
@@ -108,11 +102,9 @@ void ProgressBar::set_fill_amount(float fill_amount) {
     if (!cul::is_real(fill_amount) || fill_amount < 0.f || fill_amount > 1.f) {
         throw InvArg("ProgressBar::set_fill_amount: fill amount must be in [0 1].");
     }
+    if (m_fill_amount == fill_amount) return;
     m_fill_amount = fill_amount;
-    // it isn't clear to me how I should go about marking for needing redraw
-#   if 0
     set_needs_redraw_flag();
-#   endif
 }
 
 float ProgressBar::fill_amount() const { return m_fill_amount; }
@@ -48,11 +48,15 @@ void TextArea::stylize(const StyleMap & stylemap) {
     flag_needs_whole_family_geometry_update();
 }
 
-void TextArea::set_string(const UString & str)
-    { m_draw_text.set_string(str); }
+void TextArea::set_string(const UString & str) {
+    m_draw_text.set_string(str);
+    flag_needs_whole_family_geometry_update();
+}
 
-void TextArea::set_string(UString && str)
-    { m_draw_text.set_string(std::move(str)); }
+void TextArea::set_string(UString && str) {
+    m_draw_text.set_string(std::move(str));
+    flag_needs_whole_family_geometry_update();
+}
 
 UString TextArea::give_cleared_string()
     { return m_draw_text.give_cleared_string(); }
@@ -101,11 +101,26 @@ void Widget::assign_flags_receiver(WidgetFlagsReceiver * ptr)
 }
 
 /* protected */ void Widget::flag_needs_whole_family_geometry_update()
-    { m_flags_receiver->receive_whole_family_upate_needed(); }
+    { m_flags_receiver->receive_subtree_update_needed(this); }
 
 /* protected */ void Widget::flag_needs_individual_geometry_update()
     { m_flags_receiver->receive_individual_update_needed(this); }
 
+/* protected */ void Widget::capture_pointer()
+    { m_flags_receiver->receive_pointer_capture(this); }
+
+/* protected */ void Widget::release_pointer()
+    { m_flags_receiver->receive_pointer_release(this); }
+
+/* protected */ void Widget::flag_focus_receivers_changed()
+    { m_flags_receiver->receive_focus_receivers_changed(); }
+
+/* protected */ void Widget::set_needs_redraw_flag()
+    { m_flags_receiver->receive_redraw_needed(this); }
+
+/* protected */ void Widget::flag_region_needs_redraw(const Rectangle & region)
+    { m_flags_receiver->receive_region_redraw_needed(region); }
+
 /* static */ void Widget::Helpers::handle_required_fields
     (const char * caller, std::initializer_list<FieldFindTuple> && fields)
 {
@@ -170,11 +185,32 @@ void Widget::assign_flags_receiver(WidgetFlagsReceiver * ptr)
 // ----------------------------------------------------------------------------
 
 void WidgetFlagsReceiverWidget::receive_whole_family_upate_needed()
-    { m_geo_update_flag = true; }
+    { receive_subtree_update_needed(this); }
+
+void WidgetFlagsReceiverWidget::receive_subtree_update_needed(Widget * wid) {
+    if (!wid) {
+        throw InvArg("FlagsReceivingWidget::receive_subtree_update_needed: "
+                     "widget pointer must not be null.");
+    }
+    m_subtrees.push_back(wid);
+    // no need to tell the parent more than once
+    if (m_geo_update_flag) return;
+    m_geo_update_flag = true;
+    if (is_holding_flags()) {
+        m_holding_whole_family_flag = true;
+        return;
+    }
+    flag_needs_whole_family_geometry_update();
+}
 
 void WidgetFlagsReceiverWidget::receive_individual_update_needed(Widget * wid) {
     if (wid) {
         m_individuals.push_back(wid);
+        if (is_holding_flags()) {
+            m_holding_individual_flag = true;
+            return;
+        }
+        flag_needs_individual_geometry_update();
         return;
     }
     throw InvArg("FlagsReceivingWidget::receive_individual_update_needed: "
@@ -188,24 +224,112 @@ void WidgetFlagsReceiverWidget::receive_individual_update_needed(Widget * wid) {
         // BareFrame class
         m_geo_update_flag = false;
         m_individuals.clear();
+        m_subtrees.clear();
         return;
     }
+    update_flagged_individuals();
+}
+
+/* protected */ void WidgetFlagsReceiverWidget::take_whole_family_flags
+    (std::vector<Widget *> & flagged)
+{
+    flagged.clear();
+    flagged.swap(m_subtrees);
+    m_geo_update_flag = false;
+    std::sort(flagged.begin(), flagged.end(), std::less<Widget *>());
+    flagged.erase(std::unique(flagged.begin(), flagged.end()), flagged.end());
+}
+
+/* protected */ void WidgetFlagsReceiverWidget::update_flagged_individuals() {
+    if (m_individuals.empty()) return;
+    // placements may flag yet more individuals, those are left for the next
+    // update
+    std::vector<Widget *> individuals;
+    individuals.swap(m_individuals);
     // I've failed to find evidence that std sort uses std::less,
     // therefore I must pass it explicitly
-    std::sort(m_individuals.begin(), m_individuals.end(), std::less<Widget *>());
+    std::sort(individuals.begin(), individuals.end(), std::less<Widget *>());
     Widget * before = nullptr;
-    for (auto * widget : m_individuals) {
+    for (auto * widget : individuals) {
         if (widget == before) continue;
         // a different way to redo geometry
         auto loc = widget->location();
         widget->set_location(loc.x, loc.y);
         before = widget;
     }
-    m_individuals.clear();
+    // keep the buffer around if nothing new was flagged
+    if (!m_individuals.empty()) return;
+    individuals.clear();
+    m_individuals.swap(individuals);
 }
 
 /* protected */ bool WidgetFlagsReceiverWidget::
     needs_whole_family_geometry_update() const
     { return m_geo_update_flag; }
 
+/* protected */ void WidgetFlagsReceiverWidget::hold_flags()
+    { ++m_flag_holds; }
+
+/* protected */ void WidgetFlagsReceiverWidget::release_flags() {
+    if (!is_holding_flags()) {
+        throw RtError("WidgetFlagsReceiverWidget::release_flags: no flags are "
+                      "being held.");
+    }
+    if (--m_flag_holds > 0) return;
+    // a flag may also be left over from before the hold, if an update was
+    // turned away while holding (say by an open layout batch), in which case
+    // the receiver has since forgotten it
+    if (m_holding_whole_family_flag || m_geo_update_flag) {
+        m_holding_whole_family_flag = false;
+        flag_needs_whole_family_geometry_update();
+    }
+    if (m_holding_individual_flag) {
+        m_holding_individual_flag = false;
+        flag_needs_individual_geometry_update();
+    }
+    for (const auto & region : m_held_redraw_regions) {
+        flag_region_needs_redraw(region);
+    }
+    m_held_redraw_regions.clear();
+    if (m_holding_focus_flag) {
+        m_holding_focus_flag = false;
+        flag_focus_receivers_changed();
+    }
+    if (m_holding_pointer_flag) {
+        m_holding_pointer_flag = false;
+        if (m_held_pointer_captured) capture_pointer();
+        else                         release_pointer();
+    }
+}
+
+/* protected */ void WidgetFlagsReceiverWidget::pass_up_region_redraw_needed
+    (const Rectangle & region)
+{
+    if (is_holding_flags()) {
+        m_held_redraw_regions.push_back(region);
+        return;
+    }
+    flag_region_needs_redraw(region);
+}
+
+/* protected */ void WidgetFlagsReceiverWidget::pass_up_focus_receivers_changed() {
+    if (is_holding_flags()) {
+        m_holding_focus_flag = true;
+        return;
+    }
+    flag_focus_receivers_changed();
+}
+
+/* protected */ void WidgetFlagsReceiverWidget::pass_up_pointer_capture
+    (bool captured)
+{
+    if (is_holding_flags()) {
+        m_holding_pointer_flag  = true;
+        m_held_pointer_captured = captured;
+        return;
+    }
+    if (captured) capture_pointer();
+    else          release_pointer();
+}
+
 } // end of asgl namespace
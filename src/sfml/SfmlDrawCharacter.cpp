@@ -239,6 +239,12 @@ bool DrawableCharacter::whiped_out() const {
     return magnitude(width()) < 1.f || magnitude(height()) < 1.f;
 }
 
+void DrawableCharacter::append_to(std::vector<sf::Vertex> & verticies) const {
+    for (int idx : { k_top_left_index, k_top_right_index, k_bottom_right_index,
+                     k_top_left_index, k_bottom_right_index, k_bottom_left_index })
+    { verticies.push_back(m_verticies[std::size_t(idx)]); }
+}
+
 /* private final */ void DrawableCharacter::draw
     (sf::RenderTarget & target, sf::RenderStates states) const
 {
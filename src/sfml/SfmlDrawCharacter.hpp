@@ -31,6 +31,7 @@
 #include <SFML/Graphics/Texture.hpp>
 
 #include <array>
+#include <vector>
 
 #include <common/Vector2.hpp>
 
@@ -93,6 +94,11 @@ public:
 
     bool whiped_out() const;
 
+    /** Appends this character's quad as two triangles, so that any number of
+     *  characters may be drawn together.
+     */
+    void append_to(std::vector<sf::Vertex> &) const;
+
 private:
     void draw(sf::RenderTarget & target, sf::RenderStates states) const final;
 
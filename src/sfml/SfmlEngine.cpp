@@ -43,6 +43,8 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Window/Event.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cassert>
 
@@ -57,9 +59,10 @@ using SquareBorder      = asgl::SfmlFlatEngine::SquareBorder;
 using SfmlRenderItemMap = asgl::SfmlFlatEngine::SfmlRenderItemMap;
 using ColorItem         = asgl::SfmlFlatEngine::ColorItem;
 using SfmlImageResPtr   = asgl::SfmlFlatEngine::SfmlImageResPtr;
+using RetainedBatch     = asgl::SfmlFlatEngine::RetainedBatch;
 using asgl::WidgetRenderer, asgl::Rectangle, asgl::StyleValue, asgl::Triangle,
       asgl::TextBase, asgl::Widget, asgl::detail::SfmlImageResource,
-      asgl::SampleStyleColor, asgl::SampleStyleValue;
+      asgl::SampleStyleColor, asgl::SampleStyleValue, asgl::Vector;
 
 const std::array k_palette = [] {
     //using namespace asgl::sfml_items;
@@ -91,10 +94,15 @@ constexpr const bool is_field_type_t = StyleField::HasType<T>::k_value
     || std::is_same_v<SampleStyleColor, T>
     || std::is_same_v<SampleStyleValue, T>;
 
+/** Geometry (text included) is batched into a single list of triangles,
+ *  which is drawn all at once. The batch is drawn early only when it must be
+ *  to preserve paint order: when the texture changes, or before special
+ *  drawables.
+ */
 class SfmlWidgetRenderer final : public WidgetRenderer {
 public:
     SfmlWidgetRenderer(sf::RenderTarget &, sf::RenderStates,
-                       SfmlRenderItemMap &);
+                       SfmlRenderItemMap &, std::vector<sf::Vertex> & batch);
 
     void render_rectangle(const Rectangle &, StyleValue, const void *) final;
     void render_triangle (const Triangle  &, StyleValue, const void *) final;
@@ -104,24 +112,71 @@ public:
 
     void render_special(StyleValue, const Widget * instance_pointer) final;
 
+    void set_translation(Vector) final;
+
+    Vector translation() const final { return m_translation; }
+
+    /** Draws any geometry still waiting in the batch. */
+    void flush();
+
+    /** Skips anything drawn entirely outside of the given region. */
+    void set_clip(const Rectangle &);
+
+    /** Keeps a copy of every draw call made from here on. */
+    void keep_batches_in(std::vector<RetainedBatch> &);
+
+    int draw_call_count() const { return m_draw_calls; }
+
 private:
-    void render_rectangle(const Rectangle &, ColorItem &) const;
-    void render_triangle (const Triangle  &, ColorItem &) const;
+    void render_rectangle(const Rectangle &, const ColorItem &);
+    void render_triangle (const Triangle  &, const ColorItem &);
+
+    void render_rectangle_pair(const Rectangle &, const Rectangle &, const RoundedBorder &);
+    void render_rectangle_pair(const Rectangle &, const Rectangle &, const SquareBorder &);
+    void render_rectangle_pair(const Rectangle &, const Rectangle &, const SfmlImageResource &);
+
+    void use_texture(const sf::Texture *);
+
+    // untextured geometry may share a batch with text by sampling the white
+    // square SFML keeps on each font page
+    void use_font_texture(const sf::Texture *);
+
+    void use_no_texture();
+
+    // rectangle as given, without translation
+    bool is_clipped(const Rectangle &) const;
+
+    void append_quad(const Rectangle &, sf::Color);
 
-    void render_rectangle_pair(const Rectangle &, const Rectangle &, RoundedBorder &) const;
-    void render_rectangle_pair(const Rectangle &, const Rectangle &, SquareBorder &) const;
-    void render_rectangle_pair(const Rectangle &, const Rectangle &, SfmlImageResource &) const;
+    void append_quad(const Rectangle &, sf::Color, const Rectangle & texture_rect);
+
+    void append_vertex(float x, float y, sf::Color);
+
+    // translation is applied here, so that it need not break up batches
+    void append_vertex(float x, float y, sf::Color, sf::Vector2f tx);
 
     sf::RenderTarget & m_target;
     SfmlRenderItemMap & m_items;
     sf::RenderStates m_states;
+    // states as given, without any translation
+    sf::RenderStates m_base_states;
+    Vector m_translation;
+
+    std::vector<sf::Vertex> & m_batch;
+    const sf::Texture * m_batch_texture = nullptr;
+    // texture coordinates of untextured geometry in the current batch
+    sf::Vector2f m_untextured_coords;
+    bool m_batch_is_font_page = false;
+    int m_draw_calls = 0;
+
+    bool m_has_clip = false;
+    Rectangle m_clip;
+
+    std::vector<RetainedBatch> * m_kept_batches = nullptr;
 };
 
 asgl::Event convert(const sf::Event &);
 
-inline sf::IntRect convert_to_sfml_rectangle(const asgl::Rectangle & rect)
-    { return sf::IntRect(rect.left, rect.top, rect.width, rect.height); }
-
 template <typename T>
 inline std::enable_if_t<is_field_type_t<T>, StyleField>
     to_field(const T & obj)
@@ -136,6 +191,14 @@ inline StyleField to_field(const SampleStyleValue & obj)
     { return StyleField(asgl::SfmlFlatEngine::to_item_key(obj)); }
 
 RoundedBorder make_rounded_border(sf::Color back, sf::Color front, int padding);
+
+bool regions_overlap(const Rectangle &, const Rectangle &);
+
+Rectangle bounding_region(const Rectangle &, const Rectangle &);
+
+// regions are clipped to the given size, empty regions are removed, and too
+// many regions are merged into one
+void prepare_redraw_regions(std::vector<Rectangle> &, sf::Vector2u size);
 #if 0
 SquareBorder make_square_border(sf::Color back, sf::Color front);
 #endif
@@ -273,8 +336,33 @@ void SfmlFlatEngine::draw
 {
     // a renderer would be better described as an aggregate of some kind...
     // be it an additional member or exist for this stack frame only...
-    SfmlWidgetRenderer widren(target, states, m_items);
-    widget.draw(widren);
+    // (drawing the frame unsets this, so it must be checked first)
+    const auto * frame = widget.as_frame();
+    if (m_retained_drawing && frame && frame->needs_redraw())
+        { discard_display_list(); }
+    m_draw_call_count = 0;
+    if (m_partial_redraw) {
+        draw_through_cache(widget, target, states);
+    } else {
+        draw_widget(widget, target, states, nullptr);
+    }
+}
+
+void SfmlFlatEngine::set_retained_drawing(bool b) {
+    m_retained_drawing = b;
+    discard_display_list();
+}
+
+void SfmlFlatEngine::discard_display_list() {
+    m_display_list.clear();
+    m_display_list_owner = nullptr;
+    m_retained_batches.clear();
+}
+
+void SfmlFlatEngine::set_partial_redraw(bool b) {
+    m_partial_redraw = b;
+    m_cache = nullptr;
+    m_cached_widget = nullptr;
 }
 
 /* static */ const sf::Texture * SfmlFlatEngine::dynamic_cast_to_texture
@@ -313,6 +401,127 @@ void SfmlFlatEngine::ColorItem::update(const Triangle & trituple) {
         rectangle.color());
 }
 
+/* private */ void SfmlFlatEngine::draw_widget
+    (const Widget & widget, sf::RenderTarget & target, sf::RenderStates states,
+     const Rectangle * clip)
+{
+    if (m_retained_drawing) {
+        if (m_display_list_owner != &widget || m_display_list.is_empty()) {
+            discard_display_list();
+            widget.draw(m_display_list);
+            m_display_list_owner = &widget;
+        }
+        // clipped draws differ region to region, so only unclipped batches
+        // are kept
+        if (!clip && !m_retained_batches.empty())
+            { return draw_retained_batches(target, states); }
+    }
+    SfmlWidgetRenderer widren(target, states, m_items, m_batch_vertices);
+    if (clip) widren.set_clip(*clip);
+    if (m_retained_drawing) {
+        if (!clip) widren.keep_batches_in(m_retained_batches);
+        m_display_list.replay(widren);
+    } else {
+        widget.draw(widren);
+    }
+    widren.flush();
+    m_draw_call_count += widren.draw_call_count();
+}
+
+/* private */ void SfmlFlatEngine::draw_through_cache
+    (const Widget & widget, sf::RenderTarget & target, sf::RenderStates states)
+{
+    const auto * frame = widget.as_frame();
+    auto size = target.getSize();
+    bool full_redraw =    !frame || frame->needs_full_redraw()
+                       || m_cached_widget != &widget;
+    if (   !m_cache || m_cache->getSize().x != size.x
+        || m_cache->getSize().y != size.y)
+    {
+        m_cache = std::make_unique<sf::RenderTexture>();
+        if (!m_cache->create(size.x, size.y)) {
+            m_cache = nullptr;
+            throw RtError("SfmlFlatEngine::draw_through_cache: cannot create "
+                          "a render texture to draw into.");
+        }
+        full_redraw = true;
+    }
+    m_cached_widget = &widget;
+
+    if (full_redraw) {
+        m_cache->setView(m_cache->getDefaultView());
+        m_cache->clear(sf::Color::Transparent);
+        draw_widget(widget, *m_cache, sf::RenderStates::Default, nullptr);
+    } else if (frame->needs_redraw()) {
+        // drawing clears the frame's regions, so they must be copied
+        m_redraw_regions = frame->dirty_regions();
+        prepare_redraw_regions(m_redraw_regions, size);
+        for (const auto & region : m_redraw_regions) {
+            redraw_cached_region(widget, region);
+        }
+        m_cache->setView(m_cache->getDefaultView());
+    }
+    m_cache->display();
+
+    sf::Sprite sprite;
+    sprite.setTexture(m_cache->getTexture());
+    target.draw(sprite, states);
+    ++m_draw_call_count;
+}
+
+/* private */ void SfmlFlatEngine::draw_retained_batches
+    (sf::RenderTarget & target, sf::RenderStates states)
+{
+    for (const auto & batch : m_retained_batches) {
+        auto batch_states = states;
+        if (batch.special) {
+            batch_states.transform.translate
+                (float(batch.translation.x), float(batch.translation.y));
+            target.draw(*batch.special, batch_states);
+        } else {
+            batch_states.texture = batch.texture;
+            target.draw(batch.vertices.data(), batch.vertices.size(),
+                        sf::PrimitiveType::Triangles, batch_states);
+        }
+        ++m_draw_call_count;
+    }
+}
+
+/* private */ void SfmlFlatEngine::redraw_cached_region
+    (const Widget & widget, const Rectangle & region)
+{
+    auto size = m_cache->getSize();
+    sf::FloatRect area(float(region.left), float(region.top),
+                       float(region.width), float(region.height));
+    // a view only showing the region (and only on its pixels) clips anything
+    // drawn outside of it
+    sf::View view(area);
+    view.setViewport(sf::FloatRect(
+        area.left / float(size.x), area.top    / float(size.y),
+        area.width/ float(size.x), area.height / float(size.y)));
+    m_cache->setView(view);
+
+    // clearing the target clears all of it, so instead the region is
+    // overwritten with transparency
+    sf::RenderStates clear_states;
+    clear_states.blendMode = sf::BlendNone;
+    auto l = area.left, t = area.top;
+    auto r = area.left + area.width, b = area.top + area.height;
+    std::array<sf::Vertex, 6> clear_quad = {
+        sf::Vertex(sf::Vector2f(l, t), sf::Color::Transparent),
+        sf::Vertex(sf::Vector2f(r, t), sf::Color::Transparent),
+        sf::Vertex(sf::Vector2f(r, b), sf::Color::Transparent),
+        sf::Vertex(sf::Vector2f(l, t), sf::Color::Transparent),
+        sf::Vertex(sf::Vector2f(r, b), sf::Color::Transparent),
+        sf::Vertex(sf::Vector2f(l, b), sf::Color::Transparent)
+    };
+    m_cache->draw(clear_quad.data(), clear_quad.size(),
+                  sf::PrimitiveType::Triangles, clear_states);
+    ++m_draw_call_count;
+
+    draw_widget(widget, *m_cache, sf::RenderStates::Default, &region);
+}
+
 /* private */ SharedImagePtr SfmlFlatEngine::make_image_resource
     (const std::string & filename)
 {
@@ -370,15 +579,19 @@ Button convert(const sf::Event::JoystickButtonEvent &);
 Axis convert(const sf::Event::JoystickMoveEvent &);
 
 SfmlWidgetRenderer::SfmlWidgetRenderer
-    (sf::RenderTarget & target, sf::RenderStates states, SfmlRenderItemMap & items):
+    (sf::RenderTarget & target, sf::RenderStates states,
+     SfmlRenderItemMap & items, std::vector<sf::Vertex> & batch):
     m_target(target),
     m_items(items),
-    m_states(states)
-{}
+    m_states(states),
+    m_base_states(states),
+    m_batch(batch)
+{ m_batch.clear(); }
 
 void SfmlWidgetRenderer::render_rectangle
     (const Rectangle & rect, StyleValue itemkey, const void *)
 {
+    if (is_clipped(rect)) return;
     auto itr = m_items.find(itemkey);
     if (itr == m_items.end())
         return;
@@ -402,6 +615,14 @@ void SfmlWidgetRenderer::render_rectangle
 void SfmlWidgetRenderer::render_triangle
     (const Triangle & tuple, StyleValue itemkey, const void *)
 {
+    if (m_has_clip) {
+        using std::get, std::min, std::max;
+        auto a = get<0>(tuple), b = get<1>(tuple), c = get<2>(tuple);
+        Vector low (min(a.x, min(b.x, c.x)), min(a.y, min(b.y, c.y)));
+        Vector high(max(a.x, max(b.x, c.x)), max(a.y, max(b.y, c.y)));
+        if (is_clipped(Rectangle(low.x, low.y, high.x - low.x, high.y - low.y)))
+            { return; }
+    }
     auto itr = m_items.find(itemkey);
     if (itr == m_items.end())
         return;
@@ -419,8 +640,16 @@ void SfmlWidgetRenderer::render_triangle
 
 void SfmlWidgetRenderer::render_text(const TextBase & text_base) {
     const auto * dc_text = dynamic_cast<const asgl::detail::SfmlText *>(&text_base);
-    if (!dc_text) return;
-    m_target.draw(*dc_text, m_states);
+    if (!dc_text || !dc_text->texture()) return;
+    auto loc = text_base.location();
+    if (is_clipped(Rectangle(loc.x, loc.y, text_base.width(), text_base.height())))
+        { return; }
+    use_font_texture(dc_text->texture());
+    auto offset = dc_text->draw_offset();
+    for (const auto & vtx : dc_text->verticies()) {
+        append_vertex(vtx.position.x + offset.x, vtx.position.y + offset.y,
+                      vtx.color, vtx.texCoords);
+    }
 }
 
 void SfmlWidgetRenderer::render_rectangle_pair
@@ -428,6 +657,9 @@ void SfmlWidgetRenderer::render_rectangle_pair
 {
     auto itr = m_items.find(key);
     if (itr == m_items.end()) return;
+    // for images the second rectangle is the texture's
+    bool is_image = itr->second.type_id() == k_item_type_id<SfmlImageResPtr>;
+    if (is_clipped(is_image ? first : bounding_region(first, second))) return;
     switch (itr->second.type_id()) {
     case k_item_type_id<SfmlImageResPtr>: {
         auto ptr = itr->second.as<SfmlImageResPtr>();
@@ -457,69 +689,180 @@ void SfmlWidgetRenderer::render_special
         throw InvArg("SfmlFlatEngine::render_special: special rendering "
                      "expects that ");
     }
+    flush();
     m_target.draw(*as_drawable, m_states);
+    ++m_draw_calls;
+    if (m_kept_batches) {
+        m_kept_batches->emplace_back();
+        m_kept_batches->back().special     = as_drawable;
+        m_kept_batches->back().translation = m_translation;
+    }
+}
+
+void SfmlWidgetRenderer::set_translation(Vector r) {
+    m_translation = r;
+    m_states = m_base_states;
+    m_states.transform.translate(float(r.x), float(r.y));
+}
+
+void SfmlWidgetRenderer::flush() {
+    if (m_batch.empty()) return;
+    auto states = m_base_states;
+    states.texture = m_batch_texture;
+    m_target.draw(m_batch.data(), m_batch.size(), sf::PrimitiveType::Triangles, states);
+    if (m_kept_batches) {
+        m_kept_batches->emplace_back();
+        m_kept_batches->back().vertices = m_batch;
+        m_kept_batches->back().texture  = m_batch_texture;
+    }
+    m_batch.clear();
+    ++m_draw_calls;
+}
+
+void SfmlWidgetRenderer::set_clip(const Rectangle & rect) {
+    m_has_clip = true;
+    m_clip     = rect;
 }
 
+void SfmlWidgetRenderer::keep_batches_in(std::vector<RetainedBatch> & batches)
+    { m_kept_batches = &batches; }
+
 /* private */ void SfmlWidgetRenderer::render_rectangle
-    (const Rectangle & rect, ColorItem & color_item) const
+    (const Rectangle & rect, const ColorItem & color_item)
 {
-    color_item.update(rect);
-    m_target.draw(color_item.rectangle(), m_states);
+    use_no_texture();
+    append_quad(rect, color_item.rectangle().color());
 }
 
 /* private */ void SfmlWidgetRenderer::render_triangle
-    (const Triangle & trituple, ColorItem & color_item) const
+    (const Triangle & trituple, const ColorItem & color_item)
 {
-    color_item.update(trituple);
-    m_target.draw(color_item.triangle(), m_states);
+    use_no_texture();
+    auto color = color_item.rectangle().color();
+    for (auto pt : { std::get<0>(trituple), std::get<1>(trituple), std::get<2>(trituple) }) {
+        append_vertex(float(pt.x), float(pt.y), color);
+    }
 }
 
 /* private */ void SfmlWidgetRenderer::render_rectangle_pair
-    (const Rectangle & front, const Rectangle & back, RoundedBorder & obj) const
+    (const Rectangle & front, const Rectangle & back, const RoundedBorder & obj)
 {
-    using asgl::SfmlFlatEngine;
-    SfmlFlatEngine::update_draw_rectangle
-        (obj.back_rectangle, Rectangle(front.left, back.top, front.width, back.height));
-    m_target.draw(obj.back_rectangle, m_states);
-
-    SfmlFlatEngine::update_draw_rectangle
-        (obj.back_rectangle, Rectangle(back.left, front.top, back.width, front.height));
-    m_target.draw(obj.back_rectangle, m_states);
-
-    auto draw_circle_at = [&obj, this](float x, float y) {
-        auto nstates = m_states;
-        nstates.transform.translate(x, y);
-        m_target.draw(obj.circle.data(), obj.circle.size(), sf::PrimitiveType::Triangles, nstates);
+    use_no_texture();
+    auto back_color = obj.back_rectangle.color();
+    append_quad(Rectangle(front.left, back.top, front.width, back.height), back_color);
+    append_quad(Rectangle(back.left, front.top, back.width, front.height), back_color);
+
+    auto append_circle_at = [&obj, this](int x, int y) {
+        for (const auto & vtx : obj.circle) {
+            append_vertex(vtx.position.x + float(x), vtx.position.y + float(y),
+                          vtx.color);
+        }
     };
     // tl, tr, bl, br
-    draw_circle_at( float(front.left              ), float(front.top               ) );
-    draw_circle_at( float(front.left + front.width), float(front.top               ) );
-    draw_circle_at( float(front.left              ), float(front.top + front.height) );
-    draw_circle_at( float(front.left + front.width), float(front.top + front.height) );
+    append_circle_at( front.left              , front.top                );
+    append_circle_at( front.left + front.width, front.top                );
+    append_circle_at( front.left              , front.top + front.height );
+    append_circle_at( front.left + front.width, front.top + front.height );
 
-    SfmlFlatEngine::update_draw_rectangle(obj.front_rectangle, front);
-    m_target.draw(obj.front_rectangle, m_states);
+    append_quad(front, obj.front_rectangle.color());
 }
 
 /* private */ void SfmlWidgetRenderer::render_rectangle_pair
-    (const Rectangle & front, const Rectangle & back, SquareBorder & obj) const
+    (const Rectangle & front, const Rectangle & back, const SquareBorder & obj)
 {
-    using asgl::SfmlFlatEngine;
-    SfmlFlatEngine::update_draw_rectangle(obj.back_rectangle, front);
-    m_target.draw(obj.back_rectangle, m_states);
-
-    SfmlFlatEngine::update_draw_rectangle(obj.front_rectangle, back);
-    m_target.draw(obj.front_rectangle, m_states);
+    use_no_texture();
+    append_quad(front, obj.back_rectangle.color());
+    append_quad(back, obj.front_rectangle.color());
 }
 
 /* private */ void SfmlWidgetRenderer::render_rectangle_pair
-    (const Rectangle & bounds, const Rectangle & txrect, SfmlImageResource & obj) const
+    (const Rectangle & bounds, const Rectangle & txrect, const SfmlImageResource & obj)
 {
-    obj.sprite.setTextureRect(convert_to_sfml_rectangle(txrect));
-    obj.sprite.setPosition(float(bounds.left), float(bounds.top));
-    obj.sprite.setScale(float( bounds.width ) / float(txrect.width ),
-                        float( bounds.height) / float(txrect.height));
-    m_target.draw(obj.sprite, m_states);
+    use_texture(&obj.texture);
+    append_quad(bounds, sf::Color::White, txrect);
+}
+
+/* private */ void SfmlWidgetRenderer::use_texture(const sf::Texture * texture) {
+    if (texture == m_batch_texture) return;
+    // whatever is batched must be painted before anything else
+    flush();
+    m_batch_texture = texture;
+    m_untextured_coords = sf::Vector2f();
+    m_batch_is_font_page = false;
+}
+
+/* private */ void SfmlWidgetRenderer::use_font_texture
+    (const sf::Texture * texture)
+{
+    // center of the 2x2 white square at the top left of every font page
+    static const sf::Vector2f k_white_texel(1.f, 1.f);
+    if (texture == m_batch_texture) return;
+    if (m_batch_texture) {
+        use_texture(texture);
+    } else {
+        // anything batched so far is untextured, and may be drawn with the
+        // font's page instead
+        for (auto & vtx : m_batch) vtx.texCoords = k_white_texel;
+        m_batch_texture = texture;
+    }
+    m_untextured_coords = k_white_texel;
+    m_batch_is_font_page = true;
+}
+
+/* private */ void SfmlWidgetRenderer::use_no_texture() {
+    // a font page can draw untextured geometry just the same
+    if (m_batch_is_font_page) return;
+    use_texture(nullptr);
+}
+
+/* private */ bool SfmlWidgetRenderer::is_clipped(const Rectangle & rect) const {
+    if (!m_has_clip) return false;
+    auto moved = rect;
+    moved.left += m_translation.x;
+    moved.top  += m_translation.y;
+    return !regions_overlap(moved, m_clip);
+}
+
+/* private */ void SfmlWidgetRenderer::append_quad
+    (const Rectangle & rect, sf::Color color)
+{
+    float l = float(rect.left), r = float(rect.left + rect.width );
+    float t = float(rect.top ), b = float(rect.top  + rect.height);
+    append_vertex(l, t, color);
+    append_vertex(r, t, color);
+    append_vertex(r, b, color);
+
+    append_vertex(l, t, color);
+    append_vertex(r, b, color);
+    append_vertex(l, b, color);
+}
+
+/* private */ void SfmlWidgetRenderer::append_quad
+    (const Rectangle & rect, sf::Color color, const Rectangle & txrect)
+{
+    float l = float(rect.left), r = float(rect.left + rect.width );
+    float t = float(rect.top ), b = float(rect.top  + rect.height);
+    float tl = float(txrect.left), tr = float(txrect.left + txrect.width );
+    float tt = float(txrect.top ), tb = float(txrect.top  + txrect.height);
+    append_vertex(l, t, color, sf::Vector2f(tl, tt));
+    append_vertex(r, t, color, sf::Vector2f(tr, tt));
+    append_vertex(r, b, color, sf::Vector2f(tr, tb));
+
+    append_vertex(l, t, color, sf::Vector2f(tl, tt));
+    append_vertex(r, b, color, sf::Vector2f(tr, tb));
+    append_vertex(l, b, color, sf::Vector2f(tl, tb));
+}
+
+/* private */ void SfmlWidgetRenderer::append_vertex
+    (float x, float y, sf::Color color)
+{ append_vertex(x, y, color, m_untextured_coords); }
+
+/* private */ void SfmlWidgetRenderer::append_vertex
+    (float x, float y, sf::Color color, sf::Vector2f tx)
+{
+    m_batch.emplace_back(
+        sf::Vector2f(x + float(m_translation.x), y + float(m_translation.y)),
+        color, tx);
 }
 
 asgl::Event convert(const sf::Event & sfevent) {
@@ -573,6 +916,43 @@ RoundedBorder make_rounded_border(sf::Color back, sf::Color front, int padding)
     }
     return border;
 }
+bool regions_overlap(const Rectangle & a, const Rectangle & b) {
+    return    a.left < b.left + b.width  && b.left < a.left + a.width
+           && a.top  < b.top  + b.height && b.top  < a.top  + a.height;
+}
+
+Rectangle bounding_region(const Rectangle & a, const Rectangle & b) {
+    using std::min, std::max;
+    int left   = min(a.left, b.left);
+    int top    = min(a.top , b.top );
+    int right  = max(a.left + a.width , b.left + b.width );
+    int bottom = max(a.top  + a.height, b.top  + b.height);
+    return Rectangle(left, top, right - left, bottom - top);
+}
+
+void prepare_redraw_regions(std::vector<Rectangle> & regions, sf::Vector2u size) {
+    // past this, drawing the tree for each region costs more than it saves
+    static constexpr const std::size_t k_most_regions_redrawn = 4;
+    Rectangle whole(0, 0, int(size.x), int(size.y));
+    auto clip_to_whole = [&whole](Rectangle rect) {
+        using std::min, std::max;
+        int left   = max(rect.left, whole.left);
+        int top    = max(rect.top , whole.top );
+        int right  = min(rect.left + rect.width , whole.left + whole.width );
+        int bottom = min(rect.top  + rect.height, whole.top  + whole.height);
+        return Rectangle(left, top, max(0, right - left), max(0, bottom - top));
+    };
+    for (auto & region : regions) region = clip_to_whole(region);
+    auto rem_itr = std::remove_if(regions.begin(), regions.end(),
+        [](const Rectangle & rect) { return rect.width == 0 || rect.height == 0; });
+    regions.erase(rem_itr, regions.end());
+    if (regions.size() <= k_most_regions_redrawn) return;
+    auto merged = regions.front();
+    for (const auto & region : regions) merged = bounding_region(merged, region);
+    regions.clear();
+    regions.push_back(merged);
+}
+
 #if 0
 // I'd like to add this later to the sample rendering options...
 SquareBorder make_square_border(sf::Color back, sf::Color front) {
@@ -57,6 +57,7 @@
 #include <array>
 #include <memory>
 #include <algorithm>
+#include <mutex>
 
 #include <cmath>
 #include <cassert>
@@ -76,6 +77,11 @@ using DrawableCharacter = asgl::detail::DrawableCharacter;
 using UCharIterVector   = std::vector<UString::const_iterator>;
 using RenderablesPlacer = asgl::detail::RenderablesPlacer;
 
+// sf::Font loads glyphs (and grows its page textures) as they are first
+// asked for, frames laying out in parallel may measure text from different
+// threads
+std::recursive_mutex & glyph_mutex();
+
 inline bool is_whitespace(UChar c)
     { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
 
@@ -84,15 +90,12 @@ inline bool is_newline(UChar c) { return c == '\n'; }
 class AlgoPlacer final : public RenderablesPlacer {
 public:
     void operator () (VectorF loc, const sf::Glyph & glyph) override {
-        renderables->emplace_back(loc, glyph, *color);
-        auto & new_dc = renderables->back();
+        DrawableCharacter new_dc(loc, glyph, *color);
         new_dc.cut_outside_of(RectangleF(*viewport));
-        if (new_dc.whiped_out()) {
-            renderables->pop_back();
-            return;
-        }
+        if (new_dc.whiped_out()) return;
         full_bounds->width  = std::max(full_bounds->width , new_dc.location().x + new_dc.width ());
         full_bounds->height = std::max(full_bounds->height, new_dc.location().y + new_dc.height());
+        new_dc.append_to(*verticies);
     }
 
     UCharIterVector give_old_cleared_container() override
@@ -103,7 +106,7 @@ public:
         m_cont = std::move(cont);
     }
 
-    std::vector<DrawableCharacter> * renderables = nullptr;
+    std::vector<sf::Vertex> * verticies = nullptr;
     const sf::Color * color = nullptr;
     RectangleF * full_bounds = nullptr;
     const Rectangle * viewport = nullptr;
@@ -142,7 +145,7 @@ void TextWithFontStyle::stylize(StyleValue itemkey) {
 SfmlText::SfmlText(const SfmlText & rhs):
     m_font_ptr     (rhs.m_font_ptr     ),
     m_string       (rhs.m_string       ),
-    m_renderables  (rhs.m_renderables  ),
+    m_verticies    (rhs.m_verticies    ),
     m_placer_ptr   (nullptr            ),
     m_full_bounds  (rhs.m_full_bounds  ),
     m_limiting_line(rhs.m_limiting_line),
@@ -206,7 +209,7 @@ void SfmlText::assign_font(const sf::Font & font) { m_font_ptr = &font; }
 
 void SfmlText::update_geometry() {
     if (!m_font_ptr || m_char_size == 0) {
-        m_renderables.clear();
+        m_verticies.clear();
         return;
     }
 
@@ -218,7 +221,7 @@ void SfmlText::update_geometry() {
         placer->color       = &m_color;
         placer->full_bounds = &m_full_bounds;
         placer->viewport    = &m_viewport;
-        placer->renderables = &m_renderables;
+        placer->verticies   = &m_verticies;
         m_placer_ptr = std::move(placer);
     }
 
@@ -226,8 +229,9 @@ void SfmlText::update_geometry() {
     m_full_bounds.height = 0.f;
     m_full_bounds.width  = 0.f;
 
-    m_renderables.clear();
-    m_renderables.reserve(m_string.size());
+    // six verticies per character quad
+    m_verticies.clear();
+    m_verticies.reserve(m_string.size()*6);
     ::place_renderables(*m_font_ptr, m_string, m_limiting_line, m_char_size, *m_placer_ptr);
 }
 
@@ -239,6 +243,16 @@ void SfmlText::set_character_size_and_color
     update_geometry();
 }
 
+const sf::Texture * SfmlText::texture() const {
+    if (!m_font_ptr) return nullptr;
+    return &m_font_ptr->getTexture(unsigned(m_char_size));
+}
+
+sf::Vector2f SfmlText::draw_offset() const {
+    return sf::Vector2f(m_full_bounds.left - float(m_viewport.left),
+                        m_full_bounds.top  - float(m_viewport.top ));
+}
+
 /* private */ void SfmlText::set_viewport_(const Rectangle & rect)
     { m_viewport = rect; }
 
@@ -248,18 +262,15 @@ void SfmlText::set_character_size_and_color
 }
 
 /* private */ UString SfmlText::give_string_() {
-    m_renderables.clear();
+    m_verticies.clear();
     return std::move(m_string);
 }
 
 /* private */ void SfmlText::draw(sf::RenderTarget & target, sf::RenderStates states) const {
-    if (!m_font_ptr) return;
-    states.texture = &m_font_ptr->getTexture(unsigned(m_char_size));
-    states.transform.translate(m_full_bounds.left - float(m_viewport.left),
-                               m_full_bounds.top  - float(m_viewport.top ));
-    for (const auto & dc : m_renderables) {
-        target.draw(dc, states);
-    }
+    if (!m_font_ptr || m_verticies.empty()) return;
+    states.texture = texture();
+    states.transform.translate(draw_offset());
+    target.draw(m_verticies.data(), m_verticies.size(), sf::PrimitiveType::Triangles, states);
 }
 
 // ----------------------------------------------------------------------------
@@ -312,6 +323,7 @@ void SfmlFont::add_font_style(StyleValue key, int char_size, sf::Color color) {
 {
     if (character_size < 1) return Size();
     assert(beg <= end);
+    std::lock_guard<std::recursive_mutex> lock(glyph_mutex());
     float w = 0.f;
     for (auto itr = beg; itr != end; ++itr) {
         const auto & glyph = font.getGlyph(*itr, character_size, false);
@@ -344,6 +356,7 @@ void place_renderables
     // nothing to render
     if (ustr.empty()) return;
 
+    std::lock_guard<std::recursive_mutex> lock(glyph_mutex());
     VectorF write_pos;
     auto itr = ustr.begin();
     auto chunks = find_chunks_dividers(ustr, placer.give_old_cleared_container());
@@ -401,4 +414,9 @@ UCharIterVector find_chunks_dividers
     return rv;
 }
 
+std::recursive_mutex & glyph_mutex() {
+    static std::recursive_mutex inst;
+    return inst;
+}
+
 } // end of <anonymous> namespace
@@ -170,6 +170,18 @@ public:
 
     void set_character_size_and_color(int char_size, sf::Color) override;
 
+    /** @returns every visible character's quad, as triangles, relative to
+     *           draw_offset; these are rebuilt only by update_geometry
+     */
+    const std::vector<sf::Vertex> & verticies() const { return m_verticies; }
+
+    /** @returns font page texture used by the verticies, nullptr if there is
+     *           no font
+     */
+    const sf::Texture * texture() const;
+
+    sf::Vector2f draw_offset() const;
+
 private:
     void set_viewport_(const Rectangle &) override;
 
@@ -185,7 +197,7 @@ private:
     const sf::Font * m_font_ptr = nullptr;
     UString m_string;
 
-    std::vector<detail::DrawableCharacter> m_renderables;
+    std::vector<sf::Vertex> m_verticies;
 
     std::unique_ptr<detail::RenderablesPlacer> m_placer_ptr;
     RectangleF m_full_bounds;